@@ -45,8 +45,39 @@
 #define MAX_SIMULTANEOUS_NOTES_EMULATOR 40
 #define MAX_SIMULTANEOUS_NOTES_CONSOLE 24
 
+/**
+ * Keeps the sample DMA buffers that notes share sorted by ROM address, so finding one that already holds a sample is a binary search
+ * instead of a scan over every buffer. Buffers are also filed by the audio frame they expire on, so only the expiring ones are visited
+ * each frame instead of all of them (not supported for SH).
+ * Sample DMA hits, misses and evictions are shown on Puppyprint's audio page with or without this, to help size the number of buffers.
+ */
+// #define INDEXED_SAMPLE_DMAS
+
+/**
+ * Plays large samples (32KB or more, see load.h) from ring buffers that are refilled from ROM a few frames ahead of the play position,
+ * instead of from the small sample DMA buffers, so long music or voice samples need a few large DMAs rather than one every frame.
+ * The buffers live outside the audio heap, so this doesn't need EXPAND_AUDIO_HEAP (~37KB of RAM with the default settings; not supported for SH).
+ * Reads the ring buffer can't serve in time are counted as stream underruns on Puppyprint's audio page.
+ */
+// #define STREAMED_AUDIO_SAMPLES
+
+/**
+ * Measures how long the RSP spends on each audio task and lowers the number of notes that may play at once when it goes over budget,
+ * releasing the lowest priority and quietest notes first. The cap slowly recovers up to MAX_SIMULTANEOUS_NOTES once there is room again.
+ * Busy scenes drop background notes instead of crackling or taking RSP time from graphics. The budget is set in audio/playback.h (not supported for EU/SH).
+ * The current cap and the number of stolen notes are shown on Puppyprint's audio page.
+ */
+// #define ADAPTIVE_NOTE_CAP
+
 /** 
  * Uses a much better implementation of reverb over vanilla's fake echo reverb. Great for caves or eerie levels, as well as just a better audio experience in general.
  * Reverb presets can be configured in audio/data.c to meet desired aesthetic/performance needs. More detailed usage info can also be found on the HackerSM64 Wiki page.
  */
 // #define BETTER_REVERB
+
+/**
+ * Runs BETTER_REVERB's delay lines over blocks of samples instead of one sample at a time, which avoids reloading each delay line's
+ * state and checking its index for wrapping around on every sample. The output is identical, so this only affects CPU time,
+ * which the audio profiler counts under the envelope and reverb section.
+ */
+#define BETTER_REVERB_BLOCK_PROCESSING
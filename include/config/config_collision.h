@@ -21,6 +21,66 @@
  */
 #define ALL_SURFACES_HAVE_FORCE
 
+/**
+ * Bakes the static (level) collision partition once the area has finished loading.
+ * Instead of sorting each surface into its cell lists as it's read, the surfaces are sorted once and
+ * every cell list is written out as a contiguous array, so collision checks walk linear memory.
+ * Surface order within each list is identical to the unbaked partition.
+ */
+#define BAKED_STATIC_PARTITION
+
+/**
+ * Stores a compact copy of each surface's bounds, plane and lateral vertex positions in its surface nodes.
+ * Floor, ceiling and wall checks reject most surfaces using only this copy, so the full surface is only read on a likely hit.
+ * Costs an extra 32 bytes per surface node, which also raises the size of the dynamic surface pool.
+ */
+// #define SURFACE_QUERY_RECORDS
+
+/**
+ * Object collision models keep their surfaces between frames instead of the dynamic surface pool being rebuilt every frame.
+ * Only objects whose collision transform changed since last frame have their vertices re-transformed and surfaces re-binned.
+ * Objects that stop loading their collision (out of range, unloaded, etc.) have their surfaces removed in the same frame,
+ * once every object in their list has updated.
+ * Note that objects updated before a platform in the same frame will see the platform's surfaces from the previous frame.
+ */
+// #define INCREMENTAL_DYNAMIC_SURFACES
+
+/**
+ * Remembers the results of find_floor and find_ceil, so repeated queries at the same position return without searching the cell again.
+ * Entries are keyed by the position (after it's truncated to whole units, as the queries already do) and collision flags,
+ * and are forgotten whenever surfaces are loaded or cleared, so results are identical to uncached queries.
+ */
+// #define COLLISION_QUERY_CACHE
+
+/**
+ * Precomputes each surface's lateral edge equations and the reciprocal of its normal's Y when it's loaded.
+ * Floor and ceiling checks then test a point against a triangle with three integer multiply-adds per edge,
+ * and find the height of a hit surface with a multiply instead of a divide.
+ * Costs an extra 40 bytes per surface, and per surface node if SURFACE_QUERY_RECORDS is enabled. The dynamic surface pool grows to match.
+ */
+// #define SURFACE_EDGE_FUNCTIONS
+
+/**
+ * Groups the collision cells of an area into coarse cells of 4x4 cells, and only gives a coarse cell its own cells
+ * when it has at least SPARSE_PARTITION_THRESHOLD surfaces of level geometry, otherwise every cell in it shares one set of lists.
+ * This shrinks the static and dynamic partitions from NUM_CELLS * NUM_CELLS cells each to a small coarse grid plus
+ * the cells of dense areas, which helps extended bounds levels that are mostly empty space.
+ * Requires BAKED_STATIC_PARTITION, since which coarse cells to divide is decided once the whole area has loaded.
+ */
+// #define SPARSE_SURFACE_PARTITION
+
+/**
+ * The number of static surfaces a coarse cell needs to have before it's divided, when SPARSE_SURFACE_PARTITION is enabled.
+ */
+#define SPARSE_PARTITION_THRESHOLD 64
+
+/**
+ * Sorts objects into a coarse grid by their hitbox once per frame, so object-object collision only tests
+ * pairs whose hitboxes share a grid cell instead of every object against every list.
+ * Pairs are still tested in the same order as without it, so the same collisions are recorded.
+ */
+#define OBJECT_COLLISION_BROADPHASE
+
 /**
  * Number of walls that can push Mario at once. Vanilla is 4.
  */
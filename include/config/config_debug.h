@@ -52,6 +52,13 @@
  */
 // #define PUPPYPRINT_DEBUG_CYCLES
 
+/**
+ * Times every object's update and adds a Puppyprint page listing the behaviors that take the most CPU time,
+ * with their average time per frame, slowest single update and number of objects. Requires PUPPYPRINT_DEBUG.
+ * Behaviors are listed by address, which can be looked up in the build's map file. Uses about 18KB of RAM.
+ */
+// #define PUPPYPRINT_BEHAVIOR_PROFILER
+
 /**
  * A vanilla style debug mode. It doesn't rely on a text engine, but it's much less powerful that PUPPYPRINT_DEBUG.
  * Press D-pad left to show the debug UI.
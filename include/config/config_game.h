@@ -98,3 +98,33 @@
  * The levelscript needs to have a MARIO_POS command for this to work.
  */
 #define START_LEVEL LEVEL_CASTLE_GROUNDS
+
+/**
+ * Keeps Mario's MARIO_ANIM_CACHE_SLOTS most recently used animations loaded, instead of a single animation buffer.
+ * Each time an animation is set, the animation that followed it last time is loaded in the background,
+ * so the game only waits on a DMA for animations that haven't been used recently.
+ * Each slot is the size of the largest animation, and is allocated once from the main pool.
+ */
+// #define MARIO_ANIM_CACHE
+#define MARIO_ANIM_CACHE_SLOTS 4
+
+/**
+ * Decodes each behavior script into a stream of commands the first time an object runs it, with the command handlers,
+ * field offsets and constants already unpacked and segmented addresses already converted.
+ * Objects then run their behavior from the decoded stream instead of decoding every command every frame.
+ * Uncommon commands still run through their usual handlers, and scripts that can't be decoded run as normal.
+ * Costs BEHAVIOR_DECODE_POOL_SIZE bytes of the main pool per level.
+ */
+// #define DECODED_BEHAVIOR_SCRIPTS
+
+/**
+ * Objects with OBJ_FLAG_UPDATE_LOD only run their update every 2nd frame once they're OBJECT_UPDATE_LOD_HALF_RATE_DIST
+ * away from Mario, and every 4th frame once they're OBJECT_UPDATE_LOD_QUARTER_RATE_DIST away.
+ * Far objects are spread evenly over the frames, and their timer advances by the frames until their next update.
+ * Objects with collision or that are being held always update every frame.
+ * Only give the flag to behaviors that don't wait for exact oTimer values (other than 0), and that scale their
+ * movement, turning and frame counting by gCurrentObjectUpdateInterval, as butterflies, birds and fish do.
+ */
+// #define OBJECT_UPDATE_LOD
+#define OBJECT_UPDATE_LOD_HALF_RATE_DIST    3000.0f
+#define OBJECT_UPDATE_LOD_QUARTER_RATE_DIST 6000.0f
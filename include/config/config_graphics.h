@@ -140,6 +140,44 @@
  */
 #define DEFAULT_CULLING_RADIUS 300
 
+/**
+ * Finds the camera space position of every object and whether it's in view in a single pass over the object graph nodes,
+ * before any of them are processed. Objects that are out of view then skip building their transform entirely.
+ */
+// #define OBJECT_CULLING_PREPASS
+
+/**
+ * Remembers the decoded translation and rotation of each animated part for the rest of the frame,
+ * so objects playing the same animation on the same frame (a group of Goombas, for example) only decode it once.
+ * Hits and misses are shown on Puppyprint's standard page.
+ */
+// #define ANIMATION_DECODE_CACHE
+
+/**
+ * Sorts the display lists of the opaque and alpha layers so lists that share a material are drawn one after another,
+ * which cuts down on render state changes and texture loads in busy scenes. Other layers are drawn in their usual order.
+ * Materials are told apart by the first display list a display list calls, which is how Fast64 exports materials.
+ * The number of material changes saved is shown on Puppyprint's standard page.
+ */
+// #define SORT_DISPLAY_LISTS_BY_MATERIAL
+
+/**
+ * Keeps the fixed point matrices of objects and of level geometry's transform nodes between frames,
+ * and reuses them while their transform doesn't change instead of converting them into the GFX pool every frame.
+ * Transforms inside objects' models depend on the object, so they're still converted every frame.
+ * Costs about 208 bytes of the main pool per entry, allocated once at boot.
+ */
+// #define MATRIX_CACHE
+#define MATRIX_CACHE_SIZE 256 // Must be a power of two.
+
+/**
+ * Hides level geometry and objects in rooms that can't be seen from Mario's room, for areas with room visibility.
+ * Generate an area's room visibility from its collision with tools/room_pvs.py, add ROOM_VISIBILITY to its level script,
+ * and start each room's group of geometry in its geo layout with GEO_ASM(room, geo_room_visibility).
+ * Objects without a room have the room under them looked up every few frames.
+ */
+// #define ROOM_VISIBILITY_CULLING
+
 /**
  * Eases the textured screen transitions to make them look smoother. 
  * Extends the full radius for mario, bowser and the star transitions.
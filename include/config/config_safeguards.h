@@ -49,6 +49,18 @@
     #undef BETTER_REVERB
 #endif
 
+#if defined(ADAPTIVE_NOTE_CAP) && !(defined(VERSION_US) || defined(VERSION_JP))
+    #undef ADAPTIVE_NOTE_CAP
+#endif
+
+/*****************
+ * config_collision.h
+ */
+
+#ifndef BAKED_STATIC_PARTITION
+    #undef SPARSE_SURFACE_PARTITION
+#endif
+
 /*****************
  * config_debug.h
  */
@@ -61,6 +73,7 @@
     #undef ENABLE_DEBUG_FREE_MOVE
     #undef PUPPYPRINT_DEBUG
     #undef PUPPYPRINT_DEBUG_CYCLES
+    #undef PUPPYPRINT_BEHAVIOR_PROFILER
     #undef VANILLA_STYLE_CUSTOM_DEBUG
     #undef VISUAL_DEBUG
     #undef UNLOCK_ALL
@@ -105,6 +118,8 @@
     #define PUPPYPRINT
     #undef USE_PROFILER
     #define USE_PROFILER
+#else
+    #undef PUPPYPRINT_BEHAVIOR_PROFILER
 #endif // PUPPYPRINT_DEBUG
 
 #ifdef COMPLETE_SAVE_FILE
@@ -148,6 +163,12 @@
     #define START_LEVEL LEVEL_CASTLE_GROUNDS
 #endif // !START_LEVEL
 
+// One slot is always the current animation, so another is needed to load into.
+#if defined(MARIO_ANIM_CACHE) && (MARIO_ANIM_CACHE_SLOTS < 2)
+    #undef MARIO_ANIM_CACHE_SLOTS
+    #define MARIO_ANIM_CACHE_SLOTS 2
+#endif
+
 
 /*****************
  * config_goddard.h
@@ -71,6 +71,8 @@ enum LevelCommands {
     /*0x3D*/ LEVEL_CMD_PUPPYVOLUME,
     /*0x3E*/ LEVEL_CMD_CHANGE_AREA_SKYBOX,
     /*0x3F*/ LEVEL_CMD_SET_ECHO,
+    /*0x40*/ LEVEL_CMD_SET_OBJECT_POOL_SIZE,
+    /*0x41*/ LEVEL_CMD_SET_ROOM_VISIBILITY,
 };
 
 enum LevelActs {
@@ -399,6 +401,11 @@ enum GoddardScene {
     CMD_BBH(LEVEL_CMD_SET_ROOMS, 0x08, 0x0000), \
     CMD_PTR(surfaceRooms)
 
+// Sets the rooms that can be seen from each room of the area, as generated by tools/room_pvs.py.
+#define ROOM_VISIBILITY(numRooms, roomVisibility) \
+    CMD_BBH(LEVEL_CMD_SET_ROOM_VISIBILITY, 0x08, numRooms), \
+    CMD_PTR(roomVisibility)
+
 #define SHOW_DIALOG(index, dialogId) \
     CMD_BBBB(LEVEL_CMD_SHOW_DIALOG, 0x04, index, dialogId)
 
@@ -449,6 +456,10 @@ enum GoddardScene {
 #define SET_ECHO(console, emulator) \
     CMD_BBBB(LEVEL_CMD_SET_ECHO, 0x04, console, emulator)
 
+// Sets the object pool capacity of the next INIT_LEVEL. Must come before INIT_LEVEL.
+#define OBJECT_POOL_SIZE(capacity) \
+    CMD_BBH(LEVEL_CMD_SET_OBJECT_POOL_SIZE, 0x04, capacity)
+
 #define MACRO_OBJECTS(objList) \
     CMD_BBH(LEVEL_CMD_SET_MACRO_OBJECTS, 0x08, 0x0000), \
     CMD_PTR(objList)
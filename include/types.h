@@ -99,6 +99,8 @@ typedef s16 ColFlags;
 
 // -- Collision --
 typedef ROOM_DATA_TYPE RoomData;
+#define ROOM_VISIBILITY_WORDS 4
+typedef u32 RoomVisibility[ROOM_VISIBILITY_WORDS]; // A bit for each room that can be seen from a room.
 typedef COLLISION_DATA_TYPE Collision; // Collision is by default an s16, but it's best to have it match the type of COLLISION_DATA_TYPE
 typedef Collision TerrainData;
 typedef Collision Vec3t[3];
@@ -317,6 +319,19 @@ struct Object {
     /*0x218*/ void *collisionData;
     /*0x21C*/ Mat4 transform;
     /*0x25C*/ void *respawnInfo;
+    /*0x260*/ struct BehaviorObjectList *behaviorList; // The index list this object is in, or NULL if it isn't indexed.
+    /*0x264*/ struct Object *nextWithBehavior;
+    /*0x268*/ struct Object *prevWithBehavior;
+    /*0x26C*/ u8 objList; // The object list this object was created in.
+#ifdef OBJECT_CULLING_PREPASS
+    /*0x26D*/ u8 culledByPrepass; // Whether the object culling pre-pass found this object to be out of view this frame.
+#endif
+#ifdef ROOM_VISIBILITY_CULLING
+    /*0x26E*/ RoomData visibilityRoom; // The room found under an object without a room, updated every few frames.
+#endif
+#ifdef DECODED_BEHAVIOR_SCRIPTS
+    /*0x270*/ struct BhvDecodedCommand *curBhvDecoded; // The decoded form of curBhvCommand, or NULL if it isn't known.
+#endif
 };
 
 struct ObjectHitbox {
@@ -355,6 +370,12 @@ struct Surface {
     /*0x1C*/ struct Normal normal;
     /*0x28*/ f32 originOffset;
     /*0x2C*/ struct Object *object;
+#ifdef SURFACE_EDGE_FUNCTIONS
+    /*0x30*/ s32 edgeX[3];
+    /*0x3C*/ s32 edgeZ[3];
+    /*0x48*/ s32 edgeOffset[3];
+    /*0x54*/ f32 invNormalY;
+#endif
 };
 
 #define PUNCH_STATE_TIMER_MASK          0b00111111
@@ -0,0 +1,21 @@
+// Generated by tools/room_pvs.py from levels/castle_inside/areas/1/collision.inc.c and levels/castle_inside/areas/1/room.inc.c with a depth of 1.
+const RoomVisibility inside_castle_seg7_area_1_room_visibility[] = {
+    { 0x00000001, 0x00000000, 0x00000000, 0x00000000 }, // Room 0
+    { 0x0003FFFE, 0x00000000, 0x00000000, 0x00000000 }, // Room 1
+    { 0x00000406, 0x00000000, 0x00000000, 0x00000000 }, // Room 2
+    { 0x0000080A, 0x00000000, 0x00000000, 0x00000000 }, // Room 3
+    { 0x00001012, 0x00000000, 0x00000000, 0x00000000 }, // Room 4
+    { 0x00002022, 0x00000000, 0x00000000, 0x00000000 }, // Room 5
+    { 0x00004042, 0x00000000, 0x00000000, 0x00000000 }, // Room 6
+    { 0x00008082, 0x00000000, 0x00000000, 0x00000000 }, // Room 7
+    { 0x00010102, 0x00000000, 0x00000000, 0x00000000 }, // Room 8
+    { 0x00020202, 0x00000000, 0x00000000, 0x00000000 }, // Room 9
+    { 0x00000406, 0x00000000, 0x00000000, 0x00000000 }, // Room 10
+    { 0x0000080A, 0x00000000, 0x00000000, 0x00000000 }, // Room 11
+    { 0x00001012, 0x00000000, 0x00000000, 0x00000000 }, // Room 12
+    { 0x00002022, 0x00000000, 0x00000000, 0x00000000 }, // Room 13
+    { 0x00004042, 0x00000000, 0x00000000, 0x00000000 }, // Room 14
+    { 0x00008082, 0x00000000, 0x00000000, 0x00000000 }, // Room 15
+    { 0x00010102, 0x00000000, 0x00000000, 0x00000000 }, // Room 16
+    { 0x00020202, 0x00000000, 0x00000000, 0x00000000 }, // Room 17
+};
@@ -144,6 +144,7 @@ extern const MacroObject inside_castle_seg7_area_3_macro_objs[];
 extern const RoomData inside_castle_seg7_area_1_rooms[];
 extern const RoomData inside_castle_seg7_area_2_rooms[];
 extern const RoomData inside_castle_seg7_area_3_rooms[];
+extern const RoomVisibility inside_castle_seg7_area_1_room_visibility[];
 extern const Collision inside_castle_seg7_collision_floor_trap[];
 extern const Collision inside_castle_seg7_collision_star_door[];
 extern const Collision inside_castle_seg7_collision_water_level_pillar[];
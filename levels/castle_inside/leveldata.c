@@ -78,6 +78,7 @@
 #include "levels/castle_inside/areas/1/room.inc.c"
 #include "levels/castle_inside/areas/2/room.inc.c"
 #include "levels/castle_inside/areas/3/room.inc.c"
+#include "levels/castle_inside/areas/1/room_pvs.inc.c"
 #include "levels/castle_inside/trap_door/collision.inc.c"
 #include "levels/castle_inside/star_door/collision.inc.c"
 #include "levels/castle_inside/water_level_pillar/collision.inc.c"
@@ -660,6 +660,9 @@ struct SPTask *create_next_audio_frame_task(void) {
     flags = 0;
     if (gAudioEnabled)
     {
+#ifdef ADAPTIVE_NOTE_CAP
+        update_note_cap(gAudioRspCycles);
+#endif
         gAudioCmd = synthesis_execute(gAudioCmd, &writtenCmds, gCurrAiBuffer, gAiBufferLengths[index]);
         gAudioRandom = ((gAudioRandom + gAudioFrameCount) * gAudioFrameCount);
     }
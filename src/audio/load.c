@@ -53,6 +53,22 @@ u8 sSampleDmaReuseQueueTail2;
 u8 sSampleDmaReuseQueueHead1; // sh: 0x803505E2
 u8 sSampleDmaReuseQueueHead2; // sh: 0x803505E3
 
+#ifdef INDEXED_SAMPLE_DMAS
+// Number of audio frames the TTL wheel covers. Must be a power of two larger than the longest TTL a sample DMA is given (60).
+#define SAMPLE_DMA_WHEEL_SIZE 64
+#define SAMPLE_DMA_NONE 0xFF
+
+// The DMAs of the second list, sorted by source address.
+static u8 sSampleDmaSortedList2[MAX_SIMULTANEOUS_NOTES];
+
+// DMAs with a nonzero TTL, linked into the wheel slot of the audio frame they expire on.
+static u8 sSampleDmaWheelHeads[SAMPLE_DMA_WHEEL_SIZE];
+static u8 sSampleDmaWheelSlots[MAX_SIMULTANEOUS_NOTES * 4];
+static u8 sSampleDmaWheelNext[MAX_SIMULTANEOUS_NOTES * 4];
+static u8 sSampleDmaWheelPrev[MAX_SIMULTANEOUS_NOTES * 4];
+static u8 sSampleDmaWheelPos;
+#endif
+
 // bss correct up to here
 
 ALSeqFile *gSeqFileHeader;
@@ -152,6 +168,152 @@ void audio_dma_partial_copy_async(uintptr_t *devAddr, u8 **vAddr, ssize_t *remai
     *vAddr += transfer;
 }
 
+#ifdef INDEXED_SAMPLE_DMAS
+STATIC_ASSERT(MAX_SIMULTANEOUS_NOTES * 4 < SAMPLE_DMA_NONE, "Too many sample DMAs for INDEXED_SAMPLE_DMAS!");
+
+static void sample_dma_wheel_remove(u32 dmaIndex) {
+    u8 prev = sSampleDmaWheelPrev[dmaIndex];
+    u8 next = sSampleDmaWheelNext[dmaIndex];
+
+    if (prev == SAMPLE_DMA_NONE) {
+        sSampleDmaWheelHeads[sSampleDmaWheelSlots[dmaIndex]] = next;
+    } else {
+        sSampleDmaWheelNext[prev] = next;
+    }
+    if (next != SAMPLE_DMA_NONE) {
+        sSampleDmaWheelPrev[next] = prev;
+    }
+}
+
+/**
+ * Gives a DMA a TTL, by moving it to the wheel slot of the audio frame it will expire on.
+ */
+static void sample_dma_set_ttl(u32 dmaIndex, u8 ttl) {
+    u8 slot = (sSampleDmaWheelPos + ttl) & (SAMPLE_DMA_WHEEL_SIZE - 1);
+    u8 head;
+
+    if (sSampleTTLs[dmaIndex] != 0) {
+        sample_dma_wheel_remove(dmaIndex);
+    }
+
+    head = sSampleDmaWheelHeads[slot];
+    sSampleTTLs[dmaIndex] = ttl;
+    sSampleDmaWheelSlots[dmaIndex] = slot;
+    sSampleDmaWheelPrev[dmaIndex] = SAMPLE_DMA_NONE;
+    sSampleDmaWheelNext[dmaIndex] = head;
+    if (head != SAMPLE_DMA_NONE) {
+        sSampleDmaWheelPrev[head] = dmaIndex;
+    }
+    sSampleDmaWheelHeads[slot] = dmaIndex;
+}
+
+/**
+ * Only the DMAs expiring this frame are visited, and are added to the reuse queue of their list.
+ * sSampleTTLs holds the TTL each DMA was last given rather than counting down, and is cleared when it expires.
+ */
+void decrease_sample_dma_ttls() {
+    u32 i;
+    u32 next;
+
+    sSampleDmaWheelPos = (sSampleDmaWheelPos + 1) & (SAMPLE_DMA_WHEEL_SIZE - 1);
+    i = sSampleDmaWheelHeads[sSampleDmaWheelPos];
+    sSampleDmaWheelHeads[sSampleDmaWheelPos] = SAMPLE_DMA_NONE;
+
+    for (; i != SAMPLE_DMA_NONE; i = next) {
+        next = sSampleDmaWheelNext[i];
+        sSampleTTLs[i] = 0;
+
+        if (i < sSampleDmaListSize1) {
+            sSampleDmas[i].reuseIndex = sSampleDmaReuseQueueHead1;
+            sSampleDmaReuseQueue1[sSampleDmaReuseQueueHead1++] = (u8) i;
+        } else {
+            sSampleDmas[i].reuseIndex = sSampleDmaReuseQueueHead2;
+            sSampleDmaReuseQueue2[sSampleDmaReuseQueueHead2++] = (u8) i;
+        }
+    }
+}
+
+/**
+ * Returns the index of a DMA in the second list whose buffer covers size bytes from devAddr, or -1 if there isn't one.
+ * Every buffer in the list is the same size, so if any buffer covers the range, the one starting closest below devAddr does.
+ */
+static s32 sample_dma_find_list2(uintptr_t devAddr, u32 size) {
+    struct SharedDma *dma;
+    ssize_t bufferPos;
+    s32 lo = 0;
+    s32 hi = gSampleDmaNumListItems - sSampleDmaListSize1 - 1;
+    s32 mid;
+    s32 found = -1;
+
+    while (lo <= hi) {
+        mid = (lo + hi) >> 1;
+        if (sSampleDmas[sSampleDmaSortedList2[mid]].source <= devAddr) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    if (found < 0) {
+        return -1;
+    }
+
+    dma = &sSampleDmas[sSampleDmaSortedList2[found]];
+    bufferPos = devAddr - dma->source;
+    if ((size_t) bufferPos <= dma->bufSize - size) {
+        return sSampleDmaSortedList2[found];
+    }
+    return -1;
+}
+
+/**
+ * Changes the source of a DMA in the second list, and moves it to its new place in the sorted list.
+ */
+static void sample_dma_set_source_list2(u32 dmaIndex, uintptr_t source) {
+    u32 count = gSampleDmaNumListItems - sSampleDmaListSize1;
+    u32 pos = 0;
+
+    while (sSampleDmaSortedList2[pos] != dmaIndex) {
+        pos++;
+    }
+
+    sSampleDmas[dmaIndex].source = source;
+
+    while (pos > 0 && sSampleDmas[sSampleDmaSortedList2[pos - 1]].source > source) {
+        sSampleDmaSortedList2[pos] = sSampleDmaSortedList2[pos - 1];
+        pos--;
+    }
+    while (pos + 1 < count && sSampleDmas[sSampleDmaSortedList2[pos + 1]].source < source) {
+        sSampleDmaSortedList2[pos] = sSampleDmaSortedList2[pos + 1];
+        pos++;
+    }
+    sSampleDmaSortedList2[pos] = dmaIndex;
+}
+#else
+static ALWAYS_INLINE void sample_dma_set_ttl(u32 dmaIndex, u8 ttl) {
+    sSampleTTLs[dmaIndex] = ttl;
+}
+
+static s32 sample_dma_find_list2(uintptr_t devAddr, u32 size) {
+    struct SharedDma *dma;
+    ssize_t bufferPos;
+    u32 i;
+
+    for (i = sSampleDmaListSize1; i < gSampleDmaNumListItems; i++) {
+        dma = &sSampleDmas[i];
+        bufferPos = devAddr - dma->source;
+        if (0 <= bufferPos && (size_t) bufferPos <= dma->bufSize - size) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static ALWAYS_INLINE void sample_dma_set_source_list2(u32 dmaIndex, uintptr_t source) {
+    sSampleDmas[dmaIndex].source = source;
+}
+
 void decrease_sample_dma_ttls() {
     u32 i;
 
@@ -175,6 +337,7 @@ void decrease_sample_dma_ttls() {
         }
     }
 }
+#endif
 
 void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
     s32 hasDma = FALSE;
@@ -186,26 +349,27 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
     ssize_t bufferPos;
 
     if (arg2 != 0 || *dmaIndexRef >= sSampleDmaListSize1) {
-        for (i = sSampleDmaListSize1; i < gSampleDmaNumListItems; i++) {
+        s32 found = sample_dma_find_list2(devAddr, size);
+
+        if (found >= 0) {
+            i = found;
             dma = &sSampleDmas[i];
-            bufferPos = devAddr - dma->source;
-            if (0 <= bufferPos && (size_t) bufferPos <= dma->bufSize - size) {
-                // We already have a DMA request for this memory range.
-                if (sSampleTTLs[i] == 0 && sSampleDmaReuseQueueTail2 != sSampleDmaReuseQueueHead2) {
-                    // Move the DMA out of the reuse queue, by swapping it with the
-                    // tail, and then incrementing the tail.
-                    if (dma->reuseIndex != sSampleDmaReuseQueueTail2) {
-                        sSampleDmaReuseQueue2[dma->reuseIndex] =
-                            sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2];
-                        sSampleDmas[sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2]].reuseIndex =
-                            dma->reuseIndex;
-                    }
-                    sSampleDmaReuseQueueTail2++;
+            // We already have a DMA request for this memory range.
+            if (sSampleTTLs[i] == 0 && sSampleDmaReuseQueueTail2 != sSampleDmaReuseQueueHead2) {
+                // Move the DMA out of the reuse queue, by swapping it with the
+                // tail, and then incrementing the tail.
+                if (dma->reuseIndex != sSampleDmaReuseQueueTail2) {
+                    sSampleDmaReuseQueue2[dma->reuseIndex] =
+                        sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2];
+                    sSampleDmas[sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2]].reuseIndex =
+                        dma->reuseIndex;
                 }
-                sSampleTTLs[i] = 60;
-                *dmaIndexRef = (u8) i;
-                return (devAddr - dma->source) + dma->buffer;
+                sSampleDmaReuseQueueTail2++;
             }
+            sample_dma_set_ttl(i, 60);
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.sample_dma_hit);
+            *dmaIndexRef = (u8) i;
+            return (devAddr - dma->source) + dma->buffer;
         }
 
         if (sSampleDmaReuseQueueTail2 != sSampleDmaReuseQueueHead2 && arg2 != 0) {
@@ -214,7 +378,7 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
             dmaIndex = sSampleDmaReuseQueue2[sSampleDmaReuseQueueTail2];
             sSampleDmaReuseQueueTail2++;
             dma = sSampleDmas + dmaIndex;
-            sSampleTTLs[dmaIndex] = 2;
+            sample_dma_set_ttl(dmaIndex, 2);
             hasDma = TRUE;
         }
     } else {
@@ -233,7 +397,8 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
                 }
                 sSampleDmaReuseQueueTail1++;
             }
-            sSampleTTLs[*dmaIndexRef] = 2;
+            sample_dma_set_ttl(*dmaIndexRef, 2);
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.sample_dma_hit);
             return dma->buffer + (devAddr - dma->source);
         }
     }
@@ -243,13 +408,22 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
         // be empty, since TTL 2 is so small.
         dmaIndex = sSampleDmaReuseQueue1[sSampleDmaReuseQueueTail1++];
         dma = sSampleDmas + dmaIndex;
-        sSampleTTLs[dmaIndex] = 2;
+        sample_dma_set_ttl(dmaIndex, 2);
         hasDma = TRUE;
     }
 
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.sample_dma_miss);
+    if (dma->source != 0) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.sample_dma_evict);
+    }
+
     transfer = dma->bufSize;
     dmaDevAddr = devAddr & ~0xF;
-    dma->source = dmaDevAddr;
+    if (dmaIndex >= sSampleDmaListSize1) {
+        sample_dma_set_source_list2(dmaIndex, dmaDevAddr);
+    } else {
+        dma->source = dmaDevAddr;
+    }
 #ifdef VERSION_US // TODO: Is there a reason this only exists in US?
     osInvalDCache(dma->buffer, transfer);
 #endif
@@ -259,6 +433,223 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef) {
     return (devAddr - dmaDevAddr) + dma->buffer;
 }
 
+#ifdef STREAMED_AUDIO_SAMPLES
+#define STREAMED_SAMPLE_BUFFER_SIZE (STREAMED_SAMPLE_SEGMENT_SIZE * STREAMED_SAMPLE_SEGMENTS)
+// Reads that run past the end of the ring buffer continue into a copy of the start of its first segment.
+#define STREAMED_SAMPLE_GUARD_SIZE ALIGN16(DMA_BUF_SIZE_0)
+// A DMA for every segment, plus one for the guard copy.
+#define STREAMED_SAMPLE_DMAS_PER_STREAM (STREAMED_SAMPLE_SEGMENTS + 1)
+
+STATIC_ASSERT(STREAMED_SAMPLE_SEGMENTS >= 2, "Streamed samples need at least two segments to refill one while playing the other!");
+STATIC_ASSERT(STREAMED_SAMPLE_SEGMENT_SIZE % 0x10 == 0, "STREAMED_SAMPLE_SEGMENT_SIZE must be a multiple of 16!");
+STATIC_ASSERT(STREAMED_SAMPLE_SEGMENT_SIZE >= STREAMED_SAMPLE_GUARD_SIZE, "STREAMED_SAMPLE_SEGMENT_SIZE is too small!");
+
+// Audio frames between the last read from a ring buffer and the first DMA that may overwrite it. The command list built in a frame
+// only runs on the RSP after the frame ends, and can still be running while the next frame is built.
+#define STREAMED_SAMPLE_DMA_DELAY 2
+
+struct SampleStream {
+    struct Note *note; // NULL if the stream is free
+    struct AudioBankSample *sample;
+    uintptr_t base;       // ROM address at the start of the ring buffer
+    uintptr_t filledEnd;  // ROM address up to which DMAs have been started
+    uintptr_t readPos;    // ROM address of the last read
+    // readPos at the start of the last STREAMED_SAMPLE_DMA_DELAY frames. Command lists that may not have run yet read no
+    // further back than the oldest of these, so only segments before it can be refilled.
+    uintptr_t framePos[STREAMED_SAMPLE_DMA_DELAY];
+    u8 used;              // Whether the stream was read this frame
+    u8 primed;            // Whether the stream has served a read since it was last reset
+    u8 resetDelay;        // Frames left before a reset stream may start its DMAs
+    u8 pendingDmas[STREAMED_SAMPLE_SEGMENTS];
+};
+
+static struct SampleStream sSampleStreams[STREAMED_SAMPLE_STREAMS];
+static ALIGNED16 u8 sSampleStreamBuffers[STREAMED_SAMPLE_STREAMS][STREAMED_SAMPLE_BUFFER_SIZE + STREAMED_SAMPLE_GUARD_SIZE];
+
+// Finished DMAs are matched back to their stream and segment by their position in sSampleStreamIoMesgs.
+static OSIoMesg sSampleStreamIoMesgs[STREAMED_SAMPLE_STREAMS][STREAMED_SAMPLE_DMAS_PER_STREAM];
+static OSMesgQueue sSampleStreamDmaQueue;
+static OSMesg sSampleStreamDmaMesgs[STREAMED_SAMPLE_STREAMS * STREAMED_SAMPLE_DMAS_PER_STREAM];
+
+static void sample_stream_start_dma(s32 streamIndex, s32 dmaIndex, uintptr_t devAddr, u8 *dest, u32 size) {
+    struct SampleStream *stream = &sSampleStreams[streamIndex];
+
+    stream->pendingDmas[dmaIndex % STREAMED_SAMPLE_SEGMENTS]++;
+    osInvalDCache(dest, size);
+    osPiStartDma(&sSampleStreamIoMesgs[streamIndex][dmaIndex], OS_MESG_PRI_NORMAL, OS_READ, devAddr, dest, size, &sSampleStreamDmaQueue);
+}
+
+/**
+ * Starts DMAs for every segment that no pending command list reads from anymore, up to the end of the sample.
+ */
+static void sample_stream_refill(s32 streamIndex) {
+    struct SampleStream *stream = &sSampleStreams[streamIndex];
+    u8 *buffer = sSampleStreamBuffers[streamIndex];
+    uintptr_t sampleEnd = (uintptr_t) stream->sample->sampleAddr + stream->sample->sampleSize;
+    uintptr_t safePos = stream->framePos[STREAMED_SAMPLE_DMA_DELAY - 1];
+    s32 segment;
+
+    // A segment can be overwritten once every command list that may still be waiting for the RSP has moved past all of it
+    while (stream->filledEnd < sampleEnd
+           && stream->filledEnd + STREAMED_SAMPLE_SEGMENT_SIZE <= safePos + STREAMED_SAMPLE_BUFFER_SIZE) {
+        segment = ((stream->filledEnd - stream->base) / STREAMED_SAMPLE_SEGMENT_SIZE) % STREAMED_SAMPLE_SEGMENTS;
+
+        sample_stream_start_dma(streamIndex, segment, stream->filledEnd,
+                                &buffer[segment * STREAMED_SAMPLE_SEGMENT_SIZE], STREAMED_SAMPLE_SEGMENT_SIZE);
+        if (segment == 0) {
+            sample_stream_start_dma(streamIndex, STREAMED_SAMPLE_SEGMENTS, stream->filledEnd,
+                                    &buffer[STREAMED_SAMPLE_BUFFER_SIZE], STREAMED_SAMPLE_GUARD_SIZE);
+        }
+
+        stream->filledEnd += STREAMED_SAMPLE_SEGMENT_SIZE;
+    }
+}
+
+/**
+ * Restarts a stream at devAddr. Its buffer may still be read by command lists that haven't run yet, so the DMAs only start
+ * STREAMED_SAMPLE_DMA_DELAY frames later, in update_sample_streams. Until then the note reads through dma_sample_data.
+ */
+static void sample_stream_reset(s32 streamIndex, struct Note *note, struct AudioBankSample *sample, uintptr_t devAddr) {
+    struct SampleStream *stream = &sSampleStreams[streamIndex];
+    s32 i;
+
+    stream->note = note;
+    stream->sample = sample;
+    stream->base = devAddr & ~0xF;
+    stream->filledEnd = stream->base;
+    stream->readPos = stream->base;
+    for (i = 0; i < STREAMED_SAMPLE_DMA_DELAY; i++) {
+        stream->framePos[i] = stream->base;
+    }
+    stream->primed = FALSE;
+    stream->resetDelay = STREAMED_SAMPLE_DMA_DELAY;
+}
+
+/**
+ * Returns whether every segment holding ROM addresses [start, end) has finished its DMA.
+ */
+static s32 sample_stream_is_loaded(struct SampleStream *stream, uintptr_t start, uintptr_t end) {
+    u32 segment = (start - stream->base) / STREAMED_SAMPLE_SEGMENT_SIZE;
+    u32 lastSegment = (end - 1 - stream->base) / STREAMED_SAMPLE_SEGMENT_SIZE;
+
+    for (; segment <= lastSegment; segment++) {
+        if (stream->pendingDmas[segment % STREAMED_SAMPLE_SEGMENTS] != 0) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * Called once per audio frame, before any command list is built. Marks the DMAs that have finished since the last frame, frees the
+ * streams of notes that stopped, and refills the segments the RSP is done with.
+ */
+void update_sample_streams(void) {
+    struct SampleStream *stream;
+    OSIoMesg *mesg;
+    s32 i, j;
+
+    while (osRecvMesg(&sSampleStreamDmaQueue, (OSMesg *) &mesg, OS_MESG_NOBLOCK) != -1) {
+        i = mesg - &sSampleStreamIoMesgs[0][0];
+        sSampleStreams[i / STREAMED_SAMPLE_DMAS_PER_STREAM].pendingDmas[(i % STREAMED_SAMPLE_DMAS_PER_STREAM) % STREAMED_SAMPLE_SEGMENTS]--;
+    }
+
+    for (i = 0; i < STREAMED_SAMPLE_STREAMS; i++) {
+        stream = &sSampleStreams[i];
+        if (!stream->used) {
+            stream->note = NULL;
+        }
+        stream->used = FALSE;
+
+        for (j = STREAMED_SAMPLE_DMA_DELAY - 1; j > 0; j--) {
+            stream->framePos[j] = stream->framePos[j - 1];
+        }
+        stream->framePos[0] = stream->readPos;
+
+        if (stream->resetDelay != 0) {
+            stream->resetDelay--;
+        }
+        if (stream->note != NULL && stream->resetDelay == 0) {
+            sample_stream_refill(i);
+        }
+    }
+}
+
+/**
+ * Like dma_sample_data, but plays samples of at least STREAMED_SAMPLE_MIN_SIZE bytes from a ring buffer that is refilled ahead of
+ * the play position. Reads that the ring buffer can't serve yet fall back to dma_sample_data; if the stream was already running,
+ * that's an underrun, meaning the DMAs can't keep up with the note.
+ */
+void *dma_streamed_sample_data(struct Note *note, struct AudioBankSample *sample, uintptr_t devAddr, u32 size, s32 arg2) {
+    struct SampleStream *stream = NULL;
+    uintptr_t readStart = devAddr & ~0xF;
+    uintptr_t offset;
+    s32 streamIndex;
+    s32 i;
+
+#ifdef VERSION_EU
+    // Samples that were loaded into RAM don't need streaming.
+    if (sample->sampleSize < STREAMED_SAMPLE_MIN_SIZE || sample->loaded == 0x81) {
+#else
+    if (sample->sampleSize < STREAMED_SAMPLE_MIN_SIZE) {
+#endif
+        return dma_sample_data(devAddr, size, arg2, &note->sampleDmaIndex);
+    }
+
+    for (i = 0; i < STREAMED_SAMPLE_STREAMS; i++) {
+        if (sSampleStreams[i].note == note && sSampleStreams[i].sample == sample) {
+            stream = &sSampleStreams[i];
+            streamIndex = i;
+            break;
+        }
+    }
+
+    if (stream == NULL) {
+        for (i = 0; i < STREAMED_SAMPLE_STREAMS; i++) {
+            if (sSampleStreams[i].note == NULL) {
+                stream = &sSampleStreams[i];
+                streamIndex = i;
+                sample_stream_reset(streamIndex, note, sample, devAddr);
+                break;
+            }
+        }
+        if (stream == NULL) {
+            // Every stream is taken, so this note loads its sample like any other.
+            return dma_sample_data(devAddr, size, arg2, &note->sampleDmaIndex);
+        }
+    } else if (readStart < stream->readPos || readStart >= MAX(stream->filledEnd, stream->base + STREAMED_SAMPLE_BUFFER_SIZE)) {
+        // The note jumped back to the start of its loop, was reused for a new sound with the same sample, or got ahead of
+        // everything the stream could load.
+        sample_stream_reset(streamIndex, note, sample, devAddr);
+    }
+
+    stream->used = TRUE;
+
+    if (devAddr + size > stream->filledEnd || devAddr + size - readStart > STREAMED_SAMPLE_GUARD_SIZE
+        || !sample_stream_is_loaded(stream, readStart, devAddr + size)) {
+        if (stream->primed) {
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.sample_stream_underrun);
+        }
+        return dma_sample_data(devAddr, size, arg2, &note->sampleDmaIndex);
+    }
+
+    stream->readPos = readStart;
+    stream->primed = TRUE;
+
+    offset = (readStart - stream->base) % STREAMED_SAMPLE_BUFFER_SIZE;
+    return &sSampleStreamBuffers[streamIndex][offset] + (devAddr - readStart);
+}
+
+static void init_sample_streams(void) {
+    s32 i;
+
+    // DMAs that are still running keep their pending counts, since their messages still arrive.
+    for (i = 0; i < STREAMED_SAMPLE_STREAMS; i++) {
+        sSampleStreams[i].note = NULL;
+        sSampleStreams[i].used = FALSE;
+    }
+}
+#endif
 
 void init_sample_dma_buffers() {
     s32 i;
@@ -320,6 +711,22 @@ void init_sample_dma_buffers() {
 
     sSampleDmaReuseQueueTail2 = 0;
     sSampleDmaReuseQueueHead2 = gSampleDmaNumListItems - sSampleDmaListSize1;
+
+#ifdef INDEXED_SAMPLE_DMAS
+    // Every source is 0 at this point, so the list is already sorted.
+    for (i = sSampleDmaListSize1; (u32) i < gSampleDmaNumListItems; i++) {
+        sSampleDmaSortedList2[i - sSampleDmaListSize1] = (u8) i;
+    }
+
+    for (i = 0; i < SAMPLE_DMA_WHEEL_SIZE; i++) {
+        sSampleDmaWheelHeads[i] = SAMPLE_DMA_NONE;
+    }
+    sSampleDmaWheelPos = 0;
+#endif
+
+#ifdef STREAMED_AUDIO_SAMPLES
+    init_sample_streams();
+#endif
 }
 
 #if defined(VERSION_JP) || defined(VERSION_US)
@@ -824,6 +1231,9 @@ void audio_init() {
     osCreateMesgQueue(&gAudioDmaMesgQueue, &gAudioDmaMesg, 1);
     osCreateMesgQueue(&gCurrAudioFrameDmaQueue, gCurrAudioFrameDmaMesgBufs,
                       ARRAY_COUNT(gCurrAudioFrameDmaMesgBufs));
+#ifdef STREAMED_AUDIO_SAMPLES
+    osCreateMesgQueue(&sSampleStreamDmaQueue, sSampleStreamDmaMesgs, ARRAY_COUNT(sSampleStreamDmaMesgs));
+#endif
     gCurrAudioFrameDmaCount = 0;
     gSampleDmaNumListItems = 0;
 
@@ -7,6 +7,16 @@
 
 #define AUDIO_FRAME_DMA_QUEUE_SIZE 0x40
 
+#ifdef STREAMED_AUDIO_SAMPLES
+// How many notes can stream their sample at the same time.
+#define STREAMED_SAMPLE_STREAMS 4
+// Each stream is a ring buffer of this many segments, refilled one segment at a time once playback has moved past it.
+#define STREAMED_SAMPLE_SEGMENTS 4
+#define STREAMED_SAMPLE_SEGMENT_SIZE 0x800
+// Only samples at least this large are streamed, everything else keeps using the shared sample DMA buffers.
+#define STREAMED_SAMPLE_MIN_SIZE 0x8000
+#endif
+
 enum Preloads {
     PRELOAD_NONE,
     PRELOAD_SEQUENCE,
@@ -88,6 +98,10 @@ void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef, s3
 void *dma_sample_data(uintptr_t devAddr, u32 size, s32 arg2, u8 *dmaIndexRef);
 #endif
 void init_sample_dma_buffers();
+#ifdef STREAMED_AUDIO_SAMPLES
+void update_sample_streams(void);
+void *dma_streamed_sample_data(struct Note *note, struct AudioBankSample *sample, uintptr_t devAddr, u32 size, s32 arg2);
+#endif
 #if defined(VERSION_SH)
 void patch_audio_bank(s32 bankId, struct AudioBank *mem, struct PatchStruct *patchInfo);
 #else
@@ -8,6 +8,7 @@
 #include "synthesis.h"
 #include "effects.h"
 #include "external.h"
+#include "game/puppyprint.h"
 
 void note_set_resampling_rate(struct Note *note, f32 resamplingRateInput);
 
@@ -1187,7 +1188,104 @@ void note_release_and_take_ownership(struct Note *note, struct SequenceChannelLa
     note->adsr.action |= ADSR_ACTION_RELEASE;
 }
 
+#ifdef ADAPTIVE_NOTE_CAP
+s32 gNoteCap;
+// Notes owned by a layer, counted at the start of the frame and raised by every allocation since.
+static s32 sNotesInUse = 0;
+static s32 sFramesUnderBudget = 0;
+
+static s32 note_is_in_use(struct Note *note) {
+    return (note->parentLayer != NO_LAYER && note->priority >= NOTE_PRIORITY_MIN) || note->wantedParentLayer != NO_LAYER;
+}
+
+/**
+ * Releases the note with the lowest priority, and the quietest of those. Returns FALSE if no note can be stolen.
+ */
+static s32 steal_note(void) {
+    struct Note *best = NULL;
+    u32 bestVolume = 0;
+    struct Note *note;
+    u32 volume;
+    s32 i;
+
+    for (i = 0; i < gMaxSimultaneousNotes; i++) {
+        note = &gNotes[i];
+        // Notes that are being handed over to another layer are already releasing.
+        if (note->parentLayer == NO_LAYER || note->parentLayer->note != note
+            || note->priority < NOTE_PRIORITY_MIN || note->wantedParentLayer != NO_LAYER) {
+            continue;
+        }
+
+        volume = note->targetVolLeft + note->targetVolRight;
+        if (best == NULL || note->priority < best->priority || (note->priority == best->priority && volume < bestVolume)) {
+            best = note;
+            bestVolume = volume;
+        }
+    }
+
+    if (best == NULL) {
+        return FALSE;
+    }
+
+    // Fades out within a frame, after which process_notes moves it to the disabled list.
+    seq_channel_layer_note_release(best->parentLayer);
+    audio_list_remove(&best->listItem);
+    audio_list_push_front(&best->listItem.pool->decaying, &best->listItem);
+    best->priority = NOTE_PRIORITY_STOPPING;
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.note_steal);
+    return TRUE;
+}
+
+/**
+ * Called once per audio frame with how long the RSP took to run the last audio task.
+ * Shrinks the note cap in proportion to how far the task went over budget, grows it again one note at a time
+ * once the task has been well under budget for a while, and releases notes until no more than the cap are playing.
+ */
+void update_note_cap(u32 rspCycles) {
+    const u32 budget = OS_USEC_TO_CYCLES(ADAPTIVE_NOTE_CAP_RSP_BUDGET);
+    s32 newCap;
+    s32 i;
+
+    if (rspCycles > budget) {
+        newCap = (gNoteCap * budget) / rspCycles;
+        gNoteCap = MIN(newCap, gNoteCap - 1);
+        sFramesUnderBudget = 0;
+    } else if (rspCycles < (budget / 4) * 3) {
+        if (++sFramesUnderBudget >= ADAPTIVE_NOTE_CAP_RECOVERY_FRAMES) {
+            gNoteCap++;
+            sFramesUnderBudget = 0;
+        }
+    } else {
+        sFramesUnderBudget = 0;
+    }
+
+    if (gNoteCap > gMaxSimultaneousNotes) {
+        gNoteCap = gMaxSimultaneousNotes;
+    }
+    if (gNoteCap < ADAPTIVE_NOTE_CAP_MIN) {
+        gNoteCap = ADAPTIVE_NOTE_CAP_MIN;
+    }
+
+    sNotesInUse = 0;
+    for (i = 0; i < gMaxSimultaneousNotes; i++) {
+        if (note_is_in_use(&gNotes[i])) {
+            sNotesInUse++;
+        }
+    }
+
+    while (sNotesInUse > gNoteCap && steal_note()) {
+        sNotesInUse--;
+    }
+}
+#endif
+
 struct Note *alloc_note_from_disabled(struct NotePool *pool, struct SequenceChannelLayer *seqLayer) {
+#ifdef ADAPTIVE_NOTE_CAP
+    // At the cap, new notes can only take over a note of lower priority, see alloc_note_from_active.
+    if (sNotesInUse >= gNoteCap) {
+        return NULL;
+    }
+#endif
     struct Note *note = audio_list_pop_back(&pool->disabled);
     if (note != NULL) {
 #if defined(VERSION_EU) || defined(VERSION_SH)
@@ -1199,15 +1297,26 @@ struct Note *alloc_note_from_disabled(struct NotePool *pool, struct SequenceChan
         }
 #endif
         audio_list_push_front(&pool->active, &note->listItem);
+#ifdef ADAPTIVE_NOTE_CAP
+        sNotesInUse++;
+#endif
     }
     return note;
 }
 
 struct Note *alloc_note_from_decaying(struct NotePool *pool, struct SequenceChannelLayer *seqLayer) {
+#ifdef ADAPTIVE_NOTE_CAP
+    if (sNotesInUse >= gNoteCap) {
+        return NULL;
+    }
+#endif
     struct Note *note = audio_list_pop_back(&pool->decaying);
     if (note != NULL) {
         note_release_and_take_ownership(note, seqLayer);
         audio_list_push_back(&pool->releasing, &note->listItem);
+#ifdef ADAPTIVE_NOTE_CAP
+        sNotesInUse++;
+#endif
     }
     return note;
 }
@@ -1447,4 +1556,9 @@ void note_init_all(void) {
         note->synthesisBuffers = soundAlloc(&gNotesAndBuffersPool, ALIGN16(sizeof(struct NoteSynthesisBuffers)));
 #endif
     }
+#ifdef ADAPTIVE_NOTE_CAP
+    gNoteCap = gMaxSimultaneousNotes;
+    sNotesInUse = 0;
+    sFramesUnderBudget = 0;
+#endif
 }
@@ -32,6 +32,19 @@ struct Note *alloc_note(struct SequenceChannelLayer *seqLayer);
 void reclaim_notes(void);
 void note_init_all(void);
 
+#ifdef ADAPTIVE_NOTE_CAP
+// RSP time in microseconds the audio task may take each frame before notes get stolen.
+#define ADAPTIVE_NOTE_CAP_RSP_BUDGET 3000
+// The cap never goes below this many notes, no matter how long the audio task takes.
+#define ADAPTIVE_NOTE_CAP_MIN 8
+// Frames in a row the audio task has to stay under 3/4 of the budget before the cap grows by one note.
+#define ADAPTIVE_NOTE_CAP_RECOVERY_FRAMES 4
+
+extern s32 gNoteCap;
+
+void update_note_cap(u32 rspCycles);
+#endif
+
 #if defined(VERSION_SH)
 void note_set_vel_pan_reverb(struct Note *note, struct ReverbInfo *reverbInfo);
 #elif defined(VERSION_EU)
@@ -84,6 +84,190 @@ f32 *currentRampingTableLeft;
 f32 *currentRampingTableRight;
 
 #ifdef BETTER_REVERB
+#ifdef BETTER_REVERB_BLOCK_PROCESSING
+// Scratch space for the block of samples currently passing through the delay lines of reverb_samples().
+static s32 reverbBlockCarryover[BETTER_REVERB_BLOCK_SIZE];
+static s32 reverbBlockOutput[BETTER_REVERB_BLOCK_SIZE];
+
+/**
+ * Returns how many of the next numSamples samples can be read from a delay line before its index wraps around.
+ */
+static ALWAYS_INLINE s32 reverb_samples_before_wrap(s32 numSamples, s32 idx, s32 delay) {
+    return MIN(numSamples, delay - idx);
+}
+
+/**
+ * Mixes the output of the last delay line back into the incoming samples of a block. This only reads the delay line,
+ * which is what allows every delay line to process the whole block afterwards, as long as the block is no longer than it.
+ */
+static void reverb_block_feedback(s32 *carryover, s16 *downsampleBuffer, s32 downsampleIncrement, s32 numSamples, s16 *delayBuf, s32 idx, s32 delay, s32 revIndex) {
+    while (numSamples > 0) {
+        s32 segment = reverb_samples_before_wrap(numSamples, idx, delay);
+        s16 *curDelaySample = &delayBuf[idx];
+        s16 *segmentEnd = curDelaySample + segment;
+
+        for (; curDelaySample < segmentEnd; curDelaySample++, carryover++, downsampleBuffer += downsampleIncrement) {
+            *carryover = ((*curDelaySample * revIndex) >> 8) + *downsampleBuffer;
+        }
+
+        numSamples -= segment;
+        idx = 0;
+    }
+}
+
+/**
+ * Passes a block of samples through one allpass filter.
+ */
+static void reverb_block_allpass(s32 *carryover, s32 numSamples, s16 *delayBuf, s32 *idx, s32 delay, s32 gainIndex) {
+    s32 curIdx = *idx;
+
+    while (numSamples > 0) {
+        s32 segment = reverb_samples_before_wrap(numSamples, curIdx, delay);
+        s16 *curDelaySample = &delayBuf[curIdx];
+        s16 *segmentEnd = curDelaySample + segment;
+
+        for (; curDelaySample < segmentEnd; curDelaySample++, carryover++) {
+            s32 historySample = *curDelaySample;
+            s32 tmpCarryover = *carryover + ((historySample * (-gainIndex)) >> 8);
+
+            *curDelaySample = CLAMP_S16(tmpCarryover);
+            *carryover = ((tmpCarryover * gainIndex) >> 8) + historySample;
+        }
+
+        numSamples -= segment;
+        curIdx += segment;
+        if (curIdx == delay) curIdx = 0;
+    }
+
+    *idx = curIdx;
+}
+
+/**
+ * Passes a block of samples through the plain delay line that ends each group of three filters,
+ * adding its output to the block's output and feeding it on to the next group.
+ */
+static void reverb_block_delay(s32 *carryover, s32 *outSamples, s32 numSamples, s16 *delayBuf, s32 *idx, s32 delay, s32 reverbMult, s32 revIndex) {
+    s32 curIdx = *idx;
+
+    while (numSamples > 0) {
+        s32 segment = reverb_samples_before_wrap(numSamples, curIdx, delay);
+        s16 *curDelaySample = &delayBuf[curIdx];
+        s16 *segmentEnd = curDelaySample + segment;
+
+        for (; curDelaySample < segmentEnd; curDelaySample++, carryover++, outSamples++) {
+            s32 historySample = *curDelaySample;
+
+            *outSamples += ((historySample * reverbMult) >> 8);
+            *curDelaySample = CLAMP_S16(*carryover);
+            *carryover = ((historySample * revIndex) >> 8);
+        }
+
+        numSamples -= segment;
+        curIdx += segment;
+        if (curIdx == delay) curIdx = 0;
+    }
+
+    *idx = curIdx;
+}
+
+/**
+ * Block processed version of the per sample reverb below, with identical output. Each delay line runs over a whole block
+ * at a time, with its index only checked for wrapping around at the ends of the stretches it can't wrap in.
+ */
+static void reverb_samples(s16 *start, s16 *end, s16 *downsampleBuffer, s32 channel) {
+    s32 numSamples;
+    s32 i;
+    s32 k;
+
+    s32 downsampleIncrement = gReverbDownsampleRate;
+    s32 *delaysLocal = betterReverbDelays[channel];
+    s32 *reverbMultsLocal = reverbMults[channel];
+    s32 *allpassIdxLocal = allpassIdx[channel];
+    s16 **delayBufsLocal = delayBufs[channel];
+
+    s32 lastFilterIndex = reverbLastFilterIndex;
+    s32 revIndex = betterReverbRevIndex;
+    s32 gainIndex = betterReverbGainIndex;
+
+    while (start < end) {
+        // The feedback for the whole block is read from the last delay line before anything is written to it,
+        // so a block must not be longer than that delay line.
+        numSamples = MIN(end - start, BETTER_REVERB_BLOCK_SIZE);
+        numSamples = MIN(numSamples, delaysLocal[lastFilterIndex]);
+
+        reverb_block_feedback(reverbBlockCarryover, downsampleBuffer, downsampleIncrement, numSamples,
+                              delayBufsLocal[lastFilterIndex], allpassIdxLocal[lastFilterIndex], delaysLocal[lastFilterIndex], revIndex);
+        bzero(reverbBlockOutput, numSamples * sizeof(s32));
+
+        // Filter count is always a multiple of 3: two allpass filters followed by a plain delay line.
+        for (i = 0, k = 0; i <= lastFilterIndex; i += 3, k++) {
+            reverb_block_allpass(reverbBlockCarryover, numSamples, delayBufsLocal[i + 0], &allpassIdxLocal[i + 0], delaysLocal[i + 0], gainIndex);
+            reverb_block_allpass(reverbBlockCarryover, numSamples, delayBufsLocal[i + 1], &allpassIdxLocal[i + 1], delaysLocal[i + 1], gainIndex);
+            reverb_block_delay(reverbBlockCarryover, reverbBlockOutput, numSamples, delayBufsLocal[i + 2], &allpassIdxLocal[i + 2], delaysLocal[i + 2], reverbMultsLocal[k], revIndex);
+        }
+
+        for (i = 0; i < numSamples; i++) {
+            start[i] = CLAMP_S16(reverbBlockOutput[i]);
+        }
+
+        start += numSamples;
+        downsampleBuffer += numSamples * downsampleIncrement;
+    }
+}
+
+/**
+ * Lightweight reverb feeds each output sample straight back into the next input sample, so the samples can't be split into blocks.
+ * It instead runs in stretches that none of its delay lines wrap around in, so only the ends of those need to check.
+ */
+static void reverb_samples_light(s16 *start, s16 *end, s16 *downsampleBuffer, s32 channel) {
+    s16 *curDelaySamples[BETTER_REVERB_FILTER_COUNT_LIGHT];
+    s32 historySample;
+    s32 tmpCarryover;
+    s32 numSamples;
+    s16 *segmentEnd;
+    s32 i;
+
+    s32 downsampleIncrement = gReverbDownsampleRate;
+    s32 *delaysLocal = betterReverbDelays[channel];
+    s32 *allpassIdxLocal = allpassIdx[channel];
+    s16 **delayBufsLocal = delayBufs[channel];
+
+    // Get history sample from last processing tick
+    tmpCarryover = historySamplesLight[channel];
+
+    while (start < end) {
+        numSamples = end - start;
+        for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; ++i) {
+            numSamples = reverb_samples_before_wrap(numSamples, allpassIdxLocal[i], delaysLocal[i]);
+            curDelaySamples[i] = &delayBufsLocal[i][allpassIdxLocal[i]];
+        }
+
+        for (segmentEnd = start + numSamples; start < segmentEnd; start++, downsampleBuffer += downsampleIncrement) {
+            // Mix previous sample with new incoming sample
+            tmpCarryover = ((tmpCarryover * BETTER_REVERB_REVERB_INDEX_LIGHT) >> 8) + *downsampleBuffer;
+
+            for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; ++i) {
+                historySample = *curDelaySamples[i];
+
+                tmpCarryover += ((historySample * (-BETTER_REVERB_GAIN_INDEX_LIGHT)) >> 8);
+                *curDelaySamples[i]++ = CLAMP_S16(tmpCarryover);
+                tmpCarryover = ((tmpCarryover * BETTER_REVERB_GAIN_INDEX_LIGHT) >> 8) + historySample;
+            }
+
+            // Lightweight does not use the final filter type at all, unlike standard reverb processing
+            *start = CLAMP_S16(tmpCarryover);
+        }
+
+        for (i = 0; i < BETTER_REVERB_FILTER_COUNT_LIGHT; ++i) {
+            allpassIdxLocal[i] += numSamples;
+            if (allpassIdxLocal[i] == delaysLocal[i]) allpassIdxLocal[i] = 0;
+        }
+    }
+
+    // Copy history sample to temporary buffer for processing next tick
+    historySamplesLight[channel] = tmpCarryover;
+}
+#else
 static void reverb_samples(s16 *start, s16 *end, s16 *downsampleBuffer, s32 channel) {
     s16 *curDelaySample;
     s32 historySample;
@@ -172,6 +356,7 @@ static void reverb_samples_light(s16 *start, s16 *end, s16 *downsampleBuffer, s3
     // Copy history sample to temporary buffer for processing next tick
     historySamplesLight[channel] = tmpCarryover;
 }
+#endif // BETTER_REVERB_BLOCK_PROCESSING
 
 void initialize_better_reverb_buffers(void) {
     delayBufs[SYNTH_CHANNEL_LEFT] = (s16**) soundAlloc(&gBetterReverbPool, BETTER_REVERB_PTR_SIZE);
@@ -334,6 +519,10 @@ u64 *synthesis_execute(u64 *cmdBuf, s32 *writtenCmds, s16 *aiBuf, s32 bufLen) {
 
     aSegment(cmdBuf, 0, 0);
 
+#ifdef STREAMED_AUDIO_SAMPLES
+    update_sample_streams();
+#endif
+
 #ifdef BETTER_REVERB
     s32 filterCountDiv3 = reverbFilterCount / 3;
     reverbFilterCount = filterCountDiv3 * 3; // reverbFilterCount should always be a multiple of 3.
@@ -650,9 +839,15 @@ u64 *synthesis_process_notes(s16 *aiBuf, u32 bufLen, u64 *cmd) {
             
                             AUDIO_PROFILER_SWITCH(PROFILER_TIME_SUB_AUDIO_SYNTHESIS_PROCESSING, PROFILER_TIME_SUB_AUDIO_SYNTHESIS_DMA);
 
+#ifdef STREAMED_AUDIO_SAMPLES
+                            v0_2 = dma_streamed_sample_data(note, audioBookSample,
+                                (uintptr_t) (sampleAddr + temp * 9),
+                                t0 * 9, flags);
+#else
                             v0_2 = dma_sample_data(
                                 (uintptr_t) (sampleAddr + temp * 9),
                                 t0 * 9, flags, &note->sampleDmaIndex);
+#endif
 
                             AUDIO_PROFILER_SWITCH(PROFILER_TIME_SUB_AUDIO_SYNTHESIS_DMA, PROFILER_TIME_SUB_AUDIO_SYNTHESIS_PROCESSING);
 
@@ -39,6 +39,9 @@ enum ChannelIndexes {
 // as this default is configured to handle the emulator RCVI settings.
 #define BETTER_REVERB_SIZE ALIGN16(0xEDE0 + BETTER_REVERB_PTR_SIZE)
 
+// Number of samples each delay line processes at a time with BETTER_REVERB_BLOCK_PROCESSING. Costs 8 bytes of RAM per sample.
+#define BETTER_REVERB_BLOCK_SIZE 64
+
 
 /* ------ BETTER REVERB LIGHTWEIGHT PARAMETER OVERRIDES ------ */
 
@@ -71,6 +71,11 @@ u32 gNumVblanks        = 0;
 s8  gResetTimer        = 0;
 s8  gNmiResetBarsTimer = 0;
 s8  gDebugLevelSelect  = FALSE;
+#ifdef ADAPTIVE_NOTE_CAP
+// How long the RSP took to run the last audio task. Audio tasks are never yielded, so this is just the time from start to finish.
+u32 gAudioRspCycles = 0;
+static u32 sAudioTaskStartTime = 0;
+#endif
 
 #ifdef VANILLA_DEBUG
 s8 gShowDebugText = FALSE;
@@ -219,6 +224,9 @@ void handle_vblank(void) {
             } else {
                 pretend_audio_sptask_done();
             }
+#ifdef ADAPTIVE_NOTE_CAP
+            sAudioTaskStartTime = osGetCount();
+#endif
             profiler_rsp_started(PROFILER_RSP_AUDIO);
         }
     } else {
@@ -262,10 +270,16 @@ void handle_sp_complete(void) {
         } else {
             pretend_audio_sptask_done();
         }
+#ifdef ADAPTIVE_NOTE_CAP
+        sAudioTaskStartTime = osGetCount();
+#endif
         profiler_rsp_started(PROFILER_RSP_AUDIO);
     } else {
         curSPTask->state = SPTASK_STATE_FINISHED;
         if (curSPTask->task.t.type == M_AUDTASK) {
+#ifdef ADAPTIVE_NOTE_CAP
+            gAudioRspCycles = osGetCount() - sAudioTaskStartTime;
+#endif
             profiler_rsp_completed(PROFILER_RSP_AUDIO);
             // After audio tasks come gfx tasks.
             if ((sCurrentDisplaySPTask != NULL)
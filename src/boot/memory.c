@@ -615,11 +615,194 @@ void setup_dma_table_list(struct DmaHandlerList *list, void *srcAddr, void *buff
     }
     list->currentAddr = NULL;
     list->bufTarget = buffer;
+#ifdef MARIO_ANIM_CACHE
+    list->slots = NULL;
+#endif
+}
+
+#ifdef MARIO_ANIM_CACHE
+static OSMesgQueue sDmaCacheMesgQueue;
+static OSMesg sDmaCacheMesgBuf[1];
+static OSIoMesg sDmaCacheIoMesg;
+
+// The slot an asynchronous DMA is currently loading into. Only one is in flight at a time.
+static struct DmaCacheSlot *sDmaCacheLoadingSlot = NULL;
+
+/**
+ * Give a DMA table list numSlots buffers, each large enough for any of its entries, which are kept as a cache.
+ * Entries that were recently used, or that were prefetched, are then loaded without waiting on a DMA.
+ * Returns FALSE, leaving the list uncached, if the main pool can't fit the slots.
+ */
+s32 setup_dma_table_cache(struct DmaHandlerList *list, s32 numSlots) {
+    struct DmaTable *table = list->dmaTable;
+    u32 slotSize = 0;
+    u32 headerSize;
+    u8 *buffer;
+    u32 i;
+
+    for (i = 0; i < table->count; i++) {
+        slotSize = MAX(slotSize, ALIGN16(table->anim[i].size));
+    }
+
+    // Slots, the next index table and the slot buffers share one allocation.
+    headerSize = ALIGN16(numSlots * sizeof(struct DmaCacheSlot) + table->count * sizeof(s16));
+    buffer = main_pool_alloc(headerSize + numSlots * slotSize, MEMORY_POOL_LEFT);
+    if (buffer == NULL) {
+        return FALSE;
+    }
+
+    list->slots = (struct DmaCacheSlot *) buffer;
+    list->nextIndex = (s16 *) (buffer + numSlots * sizeof(struct DmaCacheSlot));
+
+    for (i = 0; i < (u32) numSlots; i++) {
+        list->slots[i].addr = NULL;
+        list->slots[i].buffer = buffer + headerSize + i * slotSize;
+        list->slots[i].lastUsed = 0;
+        list->slots[i].loading = FALSE;
+        list->slots[i].fresh = FALSE;
+    }
+    for (i = 0; i < table->count; i++) {
+        list->nextIndex[i] = -1;
+    }
+
+    list->currentIndex = -1;
+    list->numSlots = numSlots;
+    list->useCounter = 0;
+
+    osCreateMesgQueue(&sDmaCacheMesgQueue, sDmaCacheMesgBuf, ARRAY_COUNT(sDmaCacheMesgBuf));
+    return TRUE;
 }
 
+/**
+ * Receive the asynchronous DMA in flight if it has finished, or wait for it to finish if block is set.
+ */
+static void receive_dma_cache_load(s32 block) {
+    if (sDmaCacheLoadingSlot != NULL
+        && osRecvMesg(&sDmaCacheMesgQueue, NULL, (block ? OS_MESG_BLOCK : OS_MESG_NOBLOCK)) != -1) {
+        sDmaCacheLoadingSlot->loading = FALSE;
+        sDmaCacheLoadingSlot->fresh = TRUE;
+        sDmaCacheLoadingSlot = NULL;
+    }
+}
+
+static struct DmaCacheSlot *find_dma_cache_slot(struct DmaHandlerList *list, u8 *addr) {
+    s32 i;
+
+    for (i = 0; i < list->numSlots; i++) {
+        if (list->slots[i].addr == addr) {
+            return &list->slots[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Find the least recently used slot that isn't the current buffer or being loaded into, and empty it.
+ */
+static struct DmaCacheSlot *evict_dma_cache_slot(struct DmaHandlerList *list) {
+    struct DmaCacheSlot *oldest = NULL;
+    s32 i;
+
+    for (i = 0; i < list->numSlots; i++) {
+        struct DmaCacheSlot *slot = &list->slots[i];
+
+        if (slot->buffer != list->bufTarget && !slot->loading
+            && (oldest == NULL || slot->lastUsed < oldest->lastUsed)) {
+            oldest = slot;
+        }
+    }
+
+    if (oldest != NULL) {
+        oldest->addr = NULL;
+        oldest->fresh = FALSE;
+    }
+    return oldest;
+}
+
+/**
+ * Start loading the entry that followed this one the last time it was loaded, if it isn't already in a slot.
+ */
+static void prefetch_dma_cache_entry(struct DmaHandlerList *list, s32 index) {
+    struct DmaTable *table = list->dmaTable;
+    s32 nextIndex = list->nextIndex[index];
+
+    if (nextIndex < 0 || sDmaCacheLoadingSlot != NULL) {
+        return;
+    }
+
+    u8 *addr = table->srcAddr + table->anim[nextIndex].offset;
+    u32 size = ALIGN16(table->anim[nextIndex].size);
+
+    if (find_dma_cache_slot(list, addr) == NULL) {
+        struct DmaCacheSlot *slot = evict_dma_cache_slot(list);
+
+        if (slot != NULL) {
+            osInvalDCache(slot->buffer, size);
+            osPiStartDma(&sDmaCacheIoMesg, OS_MESG_PRI_NORMAL, OS_READ, (uintptr_t) addr, slot->buffer, size,
+                         &sDmaCacheMesgQueue);
+            slot->addr = addr;
+            slot->loading = TRUE;
+            slot->lastUsed = list->useCounter;
+            sDmaCacheLoadingSlot = slot;
+        }
+    }
+}
+
+/**
+ * load_patchable_table for lists with cache slots. Only waits on a DMA if the entry isn't in a slot,
+ * or if it's the one being prefetched and it hasn't arrived yet.
+ */
+static s32 load_patchable_table_cached(struct DmaHandlerList *list, s32 index) {
+    struct DmaTable *table = list->dmaTable;
+    u8 *addr = table->srcAddr + table->anim[index].offset;
+    struct DmaCacheSlot *slot;
+    s32 fresh;
+
+    receive_dma_cache_load(FALSE);
+
+    slot = find_dma_cache_slot(list, addr);
+    if (slot == NULL) {
+        slot = evict_dma_cache_slot(list);
+        if (slot == NULL) {
+            // Every other slot is being loaded into.
+            receive_dma_cache_load(TRUE);
+            slot = evict_dma_cache_slot(list);
+        }
+        dma_read(slot->buffer, addr, addr + table->anim[index].size);
+        slot->addr = addr;
+        slot->fresh = TRUE;
+    } else if (slot->loading) {
+        receive_dma_cache_load(TRUE);
+    }
+
+    slot->lastUsed = ++list->useCounter;
+
+    if (list->currentAddr != addr) {
+        if (list->currentIndex >= 0) {
+            list->nextIndex[list->currentIndex] = index;
+        }
+        list->currentIndex = index;
+        list->currentAddr = addr;
+        list->bufTarget = slot->buffer;
+    }
+
+    prefetch_dma_cache_entry(list, index);
+
+    fresh = slot->fresh;
+    slot->fresh = FALSE;
+    return fresh;
+}
+#endif
+
 s32 load_patchable_table(struct DmaHandlerList *list, s32 index) {
     struct DmaTable *table = list->dmaTable;
 
+#ifdef MARIO_ANIM_CACHE
+    if (list->slots != NULL) {
+        return ((u32)index < table->count) && load_patchable_table_cached(list, index);
+    }
+#endif
+
     if ((u32)index < table->count) {
         u8 *addr = table->srcAddr + table->anim[index].offset;
         s32 size = table->anim[index].size;
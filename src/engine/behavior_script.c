@@ -812,6 +812,637 @@ static BhvCommandProc BehaviorCmdTable[] = {
     /*BHV_CMD_SPAWN_WATER_DROPLET   */ bhv_cmd_spawn_water_droplet,
 };
 
+#ifdef DECODED_BEHAVIOR_SCRIPTS
+/**
+ * Decoded behavior scripts.
+ *
+ * Each run of commands from a given address up to the command that ends it (GOTO, RETURN, END_LOOP, BREAK or DEACTIVATE)
+ * is decoded the first time an object reaches it, into an array of commands with their operands already unpacked.
+ * Runs are found by the raw address of their first command, and of the commands that loops and calls jump back to.
+ * The behavior stack still holds raw addresses, so an object can switch to the script interpreter at any command,
+ * which it does whenever the command it's jumping to can't be decoded.
+ */
+
+// The most commands a single run can have. Longer runs are left to the script interpreter.
+#define BHV_DECODE_MAX_COMMANDS 256
+
+// The number of raw addresses that can be looked up. Must be a power of two.
+#define BHV_DECODE_TABLE_SIZE 512
+
+typedef s32 (*BhvDecodedProc)(void);
+
+union BhvDecodedArg {
+    s32 i;
+    u32 u;
+    f32 f;
+    void *ptr;
+    BhvCommandProc handler;
+    NativeBhvFunc native;
+    const BehaviorScript *script;
+    struct BhvDecodedCommand *cmd;
+};
+
+struct BhvDecodedCommand {
+    BhvDecodedProc proc;
+    const BehaviorScript *raw; // The command this was decoded from.
+    union BhvDecodedArg arg[2];
+};
+
+struct BhvDecodedEntry {
+    const BehaviorScript *raw;
+    struct BhvDecodedCommand *decoded; // NULL if the script at raw couldn't be decoded.
+};
+
+static struct BhvDecodedEntry sBhvDecodedTable[BHV_DECODE_TABLE_SIZE];
+static s32 sNumBhvDecodedEntries;
+static struct BhvDecodedCommand *sBhvDecodePool;
+static struct BhvDecodedCommand *sBhvDecodePoolEnd;
+
+static struct BhvDecodedCommand *sCurBhvDecoded;
+
+#define BHV_DECODED_ARG(index) (sCurBhvDecoded->arg[index])
+
+static struct BhvDecodedCommand *get_decoded_behavior_command(const BehaviorScript *raw);
+
+// Continue from the given raw command, using the decoded command previously found for it if it's still the right one.
+// Returns the decoded command, or NULL if the script interpreter has to take over.
+static struct BhvDecodedCommand *bhv_decoded_jump(const BehaviorScript *target, struct BhvDecodedCommand *cached) {
+    if (cached == NULL || cached->raw != target) {
+        cached = get_decoded_behavior_command(target);
+    }
+
+    gCurBhvCommand = target;
+    sCurBhvDecoded = cached;
+    return cached;
+}
+
+// BEGIN, and commands that don't do anything.
+static s32 bhv_decoded_next(void) {
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// Commands without a decoded version run their usual handler, stored in arg[0].
+static s32 bhv_decoded_raw(void) {
+    s32 result;
+
+    gCurBhvCommand = sCurBhvDecoded->raw;
+    result = BHV_DECODED_ARG(0).handler();
+
+    sCurBhvDecoded++;
+    return result;
+}
+
+// DELAY: arg[0] is the number of frames.
+static s32 bhv_decoded_delay(void) {
+    if (gCurrentObject->bhvDelayTimer < BHV_DECODED_ARG(0).i - 1) {
+        gCurrentObject->bhvDelayTimer++;
+    } else {
+        gCurrentObject->bhvDelayTimer = 0;
+        sCurBhvDecoded++;
+    }
+
+    return BHV_PROC_BREAK;
+}
+
+// DELAY_VAR: arg[0] is the field holding the number of frames.
+static s32 bhv_decoded_delay_var(void) {
+    s32 num = cur_obj_get_int(BHV_DECODED_ARG(0).u);
+
+    if (gCurrentObject->bhvDelayTimer < num - 1) {
+        gCurrentObject->bhvDelayTimer++;
+    } else {
+        gCurrentObject->bhvDelayTimer = 0;
+        sCurBhvDecoded++;
+    }
+
+    return BHV_PROC_BREAK;
+}
+
+// CALL: arg[0] is the script to call, arg[1] is its decoded command once found.
+static s32 bhv_decoded_call(void) {
+    struct BhvDecodedCommand *cmd = sCurBhvDecoded;
+
+    cur_obj_bhv_stack_push((uintptr_t) (cmd->raw + 2));
+    cmd->arg[1].cmd = bhv_decoded_jump(cmd->arg[0].script, cmd->arg[1].cmd);
+
+    return BHV_PROC_CONTINUE;
+}
+
+// RETURN: arg[0] is the decoded command last returned to.
+static s32 bhv_decoded_return(void) {
+    struct BhvDecodedCommand *cmd = sCurBhvDecoded;
+    const BehaviorScript *returnAddress = (const BehaviorScript *) cur_obj_bhv_stack_pop();
+
+    cmd->arg[0].cmd = bhv_decoded_jump(returnAddress, cmd->arg[0].cmd);
+
+    return BHV_PROC_CONTINUE;
+}
+
+// GOTO: arg[0] is the script to jump to, arg[1] is its decoded command once found.
+static s32 bhv_decoded_goto(void) {
+    struct BhvDecodedCommand *cmd = sCurBhvDecoded;
+
+    cmd->arg[1].cmd = bhv_decoded_jump(cmd->arg[0].script, cmd->arg[1].cmd);
+
+    return BHV_PROC_CONTINUE;
+}
+
+// BEGIN_REPEAT and BEGIN_REPEAT_UNUSED: arg[0] is the repeat count.
+static s32 bhv_decoded_begin_repeat(void) {
+    cur_obj_bhv_stack_push((uintptr_t) (sCurBhvDecoded->raw + 1));
+    cur_obj_bhv_stack_push(BHV_DECODED_ARG(0).i);
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// Shared by END_REPEAT and END_REPEAT_CONTINUE: arg[0] is the decoded command last jumped back to.
+static void bhv_decoded_end_repeat_common(void) {
+    struct BhvDecodedCommand *cmd = sCurBhvDecoded;
+    u32 count = cur_obj_bhv_stack_pop() - 1;
+
+    if (count != 0) {
+        const BehaviorScript *loopStart = (const BehaviorScript *) cur_obj_bhv_stack_pop();
+
+        cur_obj_bhv_stack_push((uintptr_t) loopStart);
+        cur_obj_bhv_stack_push(count);
+        cmd->arg[0].cmd = bhv_decoded_jump(loopStart, cmd->arg[0].cmd);
+    } else {
+        cur_obj_bhv_stack_pop();
+        sCurBhvDecoded++;
+    }
+}
+
+static s32 bhv_decoded_end_repeat(void) {
+    bhv_decoded_end_repeat_common();
+    return BHV_PROC_BREAK;
+}
+
+static s32 bhv_decoded_end_repeat_continue(void) {
+    bhv_decoded_end_repeat_common();
+    return BHV_PROC_CONTINUE;
+}
+
+// BEGIN_LOOP.
+static s32 bhv_decoded_begin_loop(void) {
+    cur_obj_bhv_stack_push((uintptr_t) (sCurBhvDecoded->raw + 1));
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// END_LOOP: arg[0] is the decoded command last jumped back to.
+static s32 bhv_decoded_end_loop(void) {
+    struct BhvDecodedCommand *cmd = sCurBhvDecoded;
+    const BehaviorScript *loopStart = (const BehaviorScript *) cur_obj_bhv_stack_pop();
+
+    cur_obj_bhv_stack_push((uintptr_t) loopStart);
+    cmd->arg[0].cmd = bhv_decoded_jump(loopStart, cmd->arg[0].cmd);
+
+    return BHV_PROC_BREAK;
+}
+
+// BREAK and BREAK_UNUSED.
+static s32 bhv_decoded_break(void) {
+    return BHV_PROC_BREAK;
+}
+
+// DEACTIVATE.
+static s32 bhv_decoded_deactivate(void) {
+    gCurrentObject->activeFlags = ACTIVE_FLAG_DEACTIVATED;
+    return BHV_PROC_BREAK;
+}
+
+// CALL_NATIVE: arg[0] is the function.
+static s32 bhv_decoded_call_native(void) {
+    BHV_DECODED_ARG(0).native();
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// ADD_FLOAT: arg[0] is the field, arg[1] the value.
+static s32 bhv_decoded_add_float(void) {
+    cur_obj_add_float(BHV_DECODED_ARG(0).u, BHV_DECODED_ARG(1).f);
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// SET_FLOAT: arg[0] is the field, arg[1] the value.
+static s32 bhv_decoded_set_float(void) {
+    cur_obj_set_float(BHV_DECODED_ARG(0).u, BHV_DECODED_ARG(1).f);
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// ADD_INT: arg[0] is the field, arg[1] the value.
+static s32 bhv_decoded_add_int(void) {
+    cur_obj_add_int(BHV_DECODED_ARG(0).u, BHV_DECODED_ARG(1).i);
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// SET_INT: arg[0] is the field, arg[1] the value.
+static s32 bhv_decoded_set_int(void) {
+    cur_obj_set_int(BHV_DECODED_ARG(0).u, BHV_DECODED_ARG(1).i);
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// OR_INT and OR_LONG: arg[0] is the field, arg[1] the bits to set.
+static s32 bhv_decoded_or_int(void) {
+    cur_obj_or_int(BHV_DECODED_ARG(0).u, BHV_DECODED_ARG(1).u);
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BIT_CLEAR: arg[0] is the field, arg[1] the mask to keep.
+static s32 bhv_decoded_bit_clear(void) {
+    cur_obj_and_int(BHV_DECODED_ARG(0).u, BHV_DECODED_ARG(1).u);
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// SET_MODEL: arg[0] is the model ID.
+static s32 bhv_decoded_set_model(void) {
+    gCurrentObject->header.gfx.sharedChild = gLoadedGraphNodes[BHV_DECODED_ARG(0).i];
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// DROP_TO_FLOOR.
+static s32 bhv_decoded_drop_to_floor(void) {
+    f32 floor = find_floor_height(gCurrentObject->oPosX, gCurrentObject->oPosY + 200.0f, gCurrentObject->oPosZ);
+    gCurrentObject->oPosY = floor;
+    gCurrentObject->oMoveFlags |= OBJ_MOVE_ON_GROUND;
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// BILLBOARD.
+static s32 bhv_decoded_billboard(void) {
+    gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_BILLBOARD;
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// HIDE.
+static s32 bhv_decoded_hide(void) {
+    cur_obj_hide();
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// SET_HITBOX: arg[0] is the radius, arg[1] the height.
+static s32 bhv_decoded_set_hitbox(void) {
+    gCurrentObject->hitboxRadius = BHV_DECODED_ARG(0).f;
+    gCurrentObject->hitboxHeight = BHV_DECODED_ARG(1).f;
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// SET_HURTBOX: arg[0] is the radius, arg[1] the height.
+static s32 bhv_decoded_set_hurtbox(void) {
+    gCurrentObject->hurtboxRadius = BHV_DECODED_ARG(0).f;
+    gCurrentObject->hurtboxHeight = BHV_DECODED_ARG(1).f;
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// LOAD_COLLISION_DATA: arg[0] is the collision data.
+static s32 bhv_decoded_load_collision_data(void) {
+    gCurrentObject->collisionData = BHV_DECODED_ARG(0).ptr;
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// SET_HOME.
+static s32 bhv_decoded_set_home(void) {
+    vec3f_copy(&o->oHomeVec, &o->oPosVec);
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// SET_INTERACT_TYPE: arg[0] is the interaction type.
+static s32 bhv_decoded_set_interact_type(void) {
+    gCurrentObject->oInteractType = BHV_DECODED_ARG(0).u;
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// SET_INTERACT_SUBTYPE: arg[0] is the interaction subtype.
+static s32 bhv_decoded_set_interact_subtype(void) {
+    gCurrentObject->oInteractionSubtype = BHV_DECODED_ARG(0).u;
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// SCALE: arg[0] is the scale.
+static s32 bhv_decoded_scale(void) {
+    cur_obj_scale(BHV_DECODED_ARG(0).f);
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// ANIMATE_TEXTURE: arg[0] is the field, arg[1] the rate.
+static s32 bhv_decoded_animate_texture(void) {
+    if ((gGlobalTimer % BHV_DECODED_ARG(1).i) == 0) {
+        cur_obj_add_int(BHV_DECODED_ARG(0).u, 1);
+    }
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// DISABLE_RENDERING.
+static s32 bhv_decoded_disable_rendering(void) {
+    gCurrentObject->header.gfx.node.flags &= ~GRAPH_RENDER_ACTIVE;
+
+    sCurBhvDecoded++;
+    return BHV_PROC_CONTINUE;
+}
+
+// How a command's operands are unpacked into its decoded arguments.
+enum BhvDecodedArgs {
+    BHV_ARGS_NONE,
+    BHV_ARGS_S16,         // arg[0]: the low half of the first word.
+    BHV_ARGS_U8,          // arg[0]: the second byte.
+    BHV_ARGS_FIELD_S16,   // arg[0]: the field, arg[1]: the low half of the first word.
+    BHV_ARGS_FIELD_F32,   // arg[0]: the field, arg[1]: the low half of the first word, as a float.
+    BHV_ARGS_FIELD_U16,   // arg[0]: the field, arg[1]: the low half of the first word, zero extended.
+    BHV_ARGS_FIELD_CLEAR, // arg[0]: the field, arg[1]: the bits BIT_CLEAR keeps.
+    BHV_ARGS_FIELD_WORD,  // arg[0]: the field, arg[1]: the second word.
+    BHV_ARGS_WORD,        // arg[0]: the second word.
+    BHV_ARGS_SCRIPT,      // arg[0]: the script in the second word, arg[1]: its decoded command once found.
+    BHV_ARGS_NATIVE,      // arg[0]: the function packed into the first word.
+    BHV_ARGS_SEGMENTED,   // arg[0]: the segmented address in the second word.
+    BHV_ARGS_HITBOX,      // arg[0]: the radius, arg[1]: the height, from the second word.
+    BHV_ARGS_SCALE,       // arg[0]: the scale percentage as a multiplier.
+};
+
+// What to do after a command when finding the extent of a run.
+#define BHV_DECODE_ENDS_RUN     (1 << 0) // The script never continues past this command.
+#define BHV_DECODE_RESUMES_NEXT (1 << 1) // The command after this one is jumped back to later.
+
+struct BhvCommandDecoding {
+    BhvDecodedProc proc; // NULL to run the command's usual handler.
+    u8 args;
+    u8 flags;
+    u8 size; // The size of the command, in words.
+};
+
+static const struct BhvCommandDecoding sBhvCommandDecodings[] = {
+    /*BHV_CMD_BEGIN                 */ { bhv_decoded_next,                 BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_DELAY                 */ { bhv_decoded_delay,                BHV_ARGS_S16,         0,                       1 },
+    /*BHV_CMD_CALL                  */ { bhv_decoded_call,                 BHV_ARGS_SCRIPT,      BHV_DECODE_RESUMES_NEXT, 2 },
+    /*BHV_CMD_RETURN                */ { bhv_decoded_return,               BHV_ARGS_NONE,        BHV_DECODE_ENDS_RUN,     1 },
+    /*BHV_CMD_GOTO                  */ { bhv_decoded_goto,                 BHV_ARGS_SCRIPT,      BHV_DECODE_ENDS_RUN,     2 },
+    /*BHV_CMD_BEGIN_REPEAT          */ { bhv_decoded_begin_repeat,         BHV_ARGS_S16,         BHV_DECODE_RESUMES_NEXT, 1 },
+    /*BHV_CMD_END_REPEAT            */ { bhv_decoded_end_repeat,           BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_END_REPEAT_CONTINUE   */ { bhv_decoded_end_repeat_continue,  BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_BEGIN_LOOP            */ { bhv_decoded_begin_loop,           BHV_ARGS_NONE,        BHV_DECODE_RESUMES_NEXT, 1 },
+    /*BHV_CMD_END_LOOP              */ { bhv_decoded_end_loop,             BHV_ARGS_NONE,        BHV_DECODE_ENDS_RUN,     1 },
+    /*BHV_CMD_BREAK                 */ { bhv_decoded_break,                BHV_ARGS_NONE,        BHV_DECODE_ENDS_RUN,     1 },
+    /*BHV_CMD_BREAK_UNUSED          */ { bhv_decoded_break,                BHV_ARGS_NONE,        BHV_DECODE_ENDS_RUN,     1 },
+    /*BHV_CMD_CALL_NATIVE           */ { bhv_decoded_call_native,          BHV_ARGS_NATIVE,      0,                       1 },
+    /*BHV_CMD_ADD_FLOAT             */ { bhv_decoded_add_float,            BHV_ARGS_FIELD_F32,   0,                       1 },
+    /*BHV_CMD_SET_FLOAT             */ { bhv_decoded_set_float,            BHV_ARGS_FIELD_F32,   0,                       1 },
+    /*BHV_CMD_ADD_INT               */ { bhv_decoded_add_int,              BHV_ARGS_FIELD_S16,   0,                       1 },
+    /*BHV_CMD_SET_INT               */ { bhv_decoded_set_int,              BHV_ARGS_FIELD_S16,   0,                       1 },
+    /*BHV_CMD_OR_INT                */ { bhv_decoded_or_int,               BHV_ARGS_FIELD_U16,   0,                       1 },
+    /*BHV_CMD_OR_LONG               */ { bhv_decoded_or_int,               BHV_ARGS_FIELD_WORD,  0,                       2 },
+    /*BHV_CMD_BIT_CLEAR             */ { bhv_decoded_bit_clear,            BHV_ARGS_FIELD_CLEAR, 0,                       1 },
+    /*BHV_CMD_SET_INT_RAND_RSHIFT   */ { NULL,                             BHV_ARGS_NONE,        0,                       2 },
+    /*BHV_CMD_SET_RANDOM_FLOAT      */ { NULL,                             BHV_ARGS_NONE,        0,                       2 },
+    /*BHV_CMD_SET_RANDOM_INT        */ { NULL,                             BHV_ARGS_NONE,        0,                       2 },
+    /*BHV_CMD_ADD_RANDOM_FLOAT      */ { NULL,                             BHV_ARGS_NONE,        0,                       2 },
+    /*BHV_CMD_ADD_INT_RAND_RSHIFT   */ { NULL,                             BHV_ARGS_NONE,        0,                       2 },
+    /*BHV_CMD_NOP_1                 */ { bhv_decoded_next,                 BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_NOP_2                 */ { bhv_decoded_next,                 BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_SET_MODEL             */ { bhv_decoded_set_model,            BHV_ARGS_S16,         0,                       1 },
+    /*BHV_CMD_SPAWN_CHILD           */ { NULL,                             BHV_ARGS_NONE,        0,                       3 },
+    /*BHV_CMD_DEACTIVATE            */ { bhv_decoded_deactivate,           BHV_ARGS_NONE,        BHV_DECODE_ENDS_RUN,     1 },
+    /*BHV_CMD_DROP_TO_FLOOR         */ { bhv_decoded_drop_to_floor,        BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_SUM_FLOAT             */ { NULL,                             BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_SUM_INT               */ { NULL,                             BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_BILLBOARD             */ { bhv_decoded_billboard,            BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_HIDE                  */ { bhv_decoded_hide,                 BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_SET_HITBOX            */ { bhv_decoded_set_hitbox,           BHV_ARGS_HITBOX,      0,                       2 },
+    /*BHV_CMD_NOP_4                 */ { bhv_decoded_next,                 BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_DELAY_VAR             */ { bhv_decoded_delay_var,            BHV_ARGS_U8,          0,                       1 },
+    /*BHV_CMD_BEGIN_REPEAT_UNUSED   */ { bhv_decoded_begin_repeat,         BHV_ARGS_U8,          BHV_DECODE_RESUMES_NEXT, 1 },
+    /*BHV_CMD_LOAD_ANIMATIONS       */ { NULL,                             BHV_ARGS_NONE,        0,                       2 },
+    /*BHV_CMD_ANIMATE               */ { NULL,                             BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_SPAWN_CHILD_WITH_PA   */ { NULL,                             BHV_ARGS_NONE,        0,                       3 },
+    /*BHV_CMD_LOAD_COLLISION_DATA   */ { bhv_decoded_load_collision_data,  BHV_ARGS_SEGMENTED,   0,                       2 },
+    /*BHV_CMD_SET_HITBOX_WITH_OFF   */ { NULL,                             BHV_ARGS_NONE,        0,                       3 },
+    /*BHV_CMD_SPAWN_OBJ             */ { NULL,                             BHV_ARGS_NONE,        0,                       3 },
+    /*BHV_CMD_SET_HOME              */ { bhv_decoded_set_home,             BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_SET_HURTBOX           */ { bhv_decoded_set_hurtbox,          BHV_ARGS_HITBOX,      0,                       2 },
+    /*BHV_CMD_SET_INTERACT_TYPE     */ { bhv_decoded_set_interact_type,    BHV_ARGS_WORD,        0,                       2 },
+    /*BHV_CMD_SET_OBJ_PHYSICS       */ { NULL,                             BHV_ARGS_NONE,        0,                       5 },
+    /*BHV_CMD_SET_INTERACT_SUBTYPE  */ { bhv_decoded_set_interact_subtype, BHV_ARGS_WORD,        0,                       2 },
+    /*BHV_CMD_SCALE                 */ { bhv_decoded_scale,                BHV_ARGS_SCALE,       0,                       1 },
+    /*BHV_CMD_PARENT_BIT_CLEAR      */ { NULL,                             BHV_ARGS_NONE,        0,                       2 },
+    /*BHV_CMD_ANIMATE_TEXTURE       */ { bhv_decoded_animate_texture,      BHV_ARGS_FIELD_S16,   0,                       1 },
+    /*BHV_CMD_DISABLE_RENDERING     */ { bhv_decoded_disable_rendering,    BHV_ARGS_NONE,        0,                       1 },
+    /*BHV_CMD_SET_INT_UNUSED        */ { NULL,                             BHV_ARGS_NONE,        0,                       2 },
+    /*BHV_CMD_SPAWN_WATER_DROPLET   */ { NULL,                             BHV_ARGS_NONE,        0,                       1 },
+};
+
+STATIC_ASSERT(ARRAY_COUNT(sBhvCommandDecodings) == ARRAY_COUNT(BehaviorCmdTable), "Every behavior command needs a decoding");
+
+void alloc_behavior_decode_pool(void) {
+    bzero(sBhvDecodedTable, sizeof(sBhvDecodedTable));
+    sNumBhvDecodedEntries = 0;
+
+    // Without a pool nothing is decoded, and every object runs its script as usual.
+    sBhvDecodePool = main_pool_alloc(BEHAVIOR_DECODE_POOL_SIZE, MEMORY_POOL_LEFT);
+    sBhvDecodePoolEnd = sBhvDecodePool;
+    if (sBhvDecodePool != NULL) {
+        sBhvDecodePoolEnd += BEHAVIOR_DECODE_POOL_SIZE / sizeof(struct BhvDecodedCommand);
+    }
+}
+
+// Find the table entry for a raw address, or the empty entry to add it in if it isn't in the table.
+// Returns NULL if it isn't in the table and the table is too full to add it.
+static struct BhvDecodedEntry *find_bhv_decoded_entry(const BehaviorScript *raw) {
+    u32 i = ((((uintptr_t) raw >> 2) * 2654435761U) >> 16);
+
+    while (TRUE) {
+        struct BhvDecodedEntry *entry = &sBhvDecodedTable[i & (BHV_DECODE_TABLE_SIZE - 1)];
+
+        if (entry->raw == raw) {
+            return entry;
+        }
+
+        if (entry->raw == NULL) {
+            // Keep the table at most 3/4 full so probes stay short.
+            if (sNumBhvDecodedEntries >= (BHV_DECODE_TABLE_SIZE * 3 / 4)) {
+                return NULL;
+            }
+
+            return entry;
+        }
+
+        i++;
+    }
+}
+
+static void decode_behavior_command(struct BhvDecodedCommand *cmd, const BehaviorScript *raw) {
+    u32 op = (*raw >> 24);
+    const struct BhvCommandDecoding *decoding = &sBhvCommandDecodings[op];
+
+    cmd->raw = raw;
+    cmd->arg[0].ptr = NULL;
+    cmd->arg[1].ptr = NULL;
+
+    if (decoding->proc == NULL) {
+        cmd->proc = bhv_decoded_raw;
+        cmd->arg[0].handler = BehaviorCmdTable[op];
+        return;
+    }
+
+    cmd->proc = decoding->proc;
+
+    switch (decoding->args) {
+        case BHV_ARGS_S16:
+            cmd->arg[0].i = (s16)(raw[0] & 0xFFFF);
+            break;
+        case BHV_ARGS_U8:
+            cmd->arg[0].u = ((raw[0] >> 16) & 0xFF);
+            break;
+        case BHV_ARGS_FIELD_S16:
+            cmd->arg[0].u = ((raw[0] >> 16) & 0xFF);
+            cmd->arg[1].i = (s16)(raw[0] & 0xFFFF);
+            break;
+        case BHV_ARGS_FIELD_F32:
+            cmd->arg[0].u = ((raw[0] >> 16) & 0xFF);
+            cmd->arg[1].f = (s16)(raw[0] & 0xFFFF);
+            break;
+        case BHV_ARGS_FIELD_U16:
+            cmd->arg[0].u = ((raw[0] >> 16) & 0xFF);
+            cmd->arg[1].u = (raw[0] & 0xFFFF);
+            break;
+        case BHV_ARGS_FIELD_CLEAR:
+            cmd->arg[0].u = ((raw[0] >> 16) & 0xFF);
+            cmd->arg[1].u = ((raw[0] & 0xFFFF) ^ 0xFFFF);
+            break;
+        case BHV_ARGS_FIELD_WORD:
+            cmd->arg[0].u = ((raw[0] >> 16) & 0xFF);
+            cmd->arg[1].u = raw[1];
+            break;
+        case BHV_ARGS_WORD:
+            cmd->arg[0].u = raw[1];
+            break;
+        case BHV_ARGS_SCRIPT:
+            cmd->arg[0].script = segmented_to_virtual((void *) raw[1]);
+            break;
+        case BHV_ARGS_NATIVE:
+            cmd->arg[0].native = (NativeBhvFunc) OS_PHYSICAL_TO_K0(raw[0] & 0xFFFFFF);
+            break;
+        case BHV_ARGS_SEGMENTED:
+            cmd->arg[0].ptr = segmented_to_virtual((void *) raw[1]);
+            break;
+        case BHV_ARGS_HITBOX:
+            cmd->arg[0].f = (s16)(raw[1] >> 16);
+            cmd->arg[1].f = (s16)(raw[1] & 0xFFFF);
+            break;
+        case BHV_ARGS_SCALE:
+            cmd->arg[0].f = (s16)(raw[0] & 0xFFFF) / 100.0f;
+            break;
+    }
+}
+
+// Decode the run of commands starting at the given address. Returns NULL if it can't be decoded.
+static struct BhvDecodedCommand *decode_behavior_run(const BehaviorScript *start) {
+    const BehaviorScript *raw = start;
+    struct BhvDecodedCommand *run;
+    s32 numCommands = 0;
+    s32 i;
+
+    while (TRUE) {
+        u32 op = (*raw >> 24);
+
+        if (op >= (u32) ARRAY_COUNT(sBhvCommandDecodings) || numCommands >= BHV_DECODE_MAX_COMMANDS) {
+            return NULL;
+        }
+
+        numCommands++;
+        if (sBhvCommandDecodings[op].flags & BHV_DECODE_ENDS_RUN) {
+            break;
+        }
+
+        raw += sBhvCommandDecodings[op].size;
+    }
+
+    if (sBhvDecodePoolEnd - sBhvDecodePool < numCommands) {
+        return NULL;
+    }
+
+    run = sBhvDecodePool;
+    sBhvDecodePool += numCommands;
+
+    raw = start;
+    for (i = 0; i < numCommands; i++) {
+        const struct BhvCommandDecoding *decoding = &sBhvCommandDecodings[*raw >> 24];
+
+        decode_behavior_command(&run[i], raw);
+        raw += decoding->size;
+
+        // Let loops and calls find the command they return to in this run, rather than decoding another run from it.
+        if (decoding->flags & BHV_DECODE_RESUMES_NEXT) {
+            struct BhvDecodedEntry *entry = find_bhv_decoded_entry(raw);
+
+            if (entry != NULL && entry->raw == NULL) {
+                sNumBhvDecodedEntries++;
+                entry->raw = raw;
+                entry->decoded = &run[i + 1];
+            }
+        }
+    }
+
+    return run;
+}
+
+// Get the decoded command for the given raw command, decoding a run from it if needed.
+// Returns NULL if it can't be decoded, in which case the script interpreter runs it instead.
+static struct BhvDecodedCommand *get_decoded_behavior_command(const BehaviorScript *raw) {
+    struct BhvDecodedEntry *entry = find_bhv_decoded_entry(raw);
+
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    // Failed runs keep their entry too, so they aren't tried again.
+    if (entry->raw == NULL) {
+        sNumBhvDecodedEntries++;
+        entry->raw = raw;
+        entry->decoded = decode_behavior_run(raw);
+    }
+
+    return entry->decoded;
+}
+#endif
+
 // Execute the behavior script of the current object, process the object flags, and other miscellaneous code for updating objects.
 void cur_obj_update(void) {
     u32 objFlags = o->oFlags;
@@ -849,10 +1480,32 @@ void cur_obj_update(void) {
     // Execute the behavior script.
     gCurBhvCommand = o->curBhvCommand;
 
+#ifdef DECODED_BEHAVIOR_SCRIPTS
+    sCurBhvDecoded = o->curBhvDecoded;
+    if (sCurBhvDecoded == NULL || sCurBhvDecoded->raw != gCurBhvCommand) {
+        sCurBhvDecoded = get_decoded_behavior_command(gCurBhvCommand);
+    }
+
+    // Commands switch to the script interpreter by clearing sCurBhvDecoded.
+    do {
+        if (sCurBhvDecoded != NULL) {
+            bhvProcResult = sCurBhvDecoded->proc();
+        } else {
+            bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
+            bhvProcResult = bhvCmdProc();
+        }
+    } while (bhvProcResult == BHV_PROC_CONTINUE);
+
+    if (sCurBhvDecoded != NULL) {
+        gCurBhvCommand = sCurBhvDecoded->raw;
+    }
+    o->curBhvDecoded = sCurBhvDecoded;
+#else
     do {
         bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
         bhvProcResult = bhvCmdProc();
     } while (bhvProcResult == BHV_PROC_CONTINUE);
+#endif
 
     o->curBhvCommand = gCurBhvCommand;
 
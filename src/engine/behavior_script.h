@@ -21,6 +21,15 @@ enum BhvProc {
 
 #define obj_and_int(object, offset, value) object->OBJECT_FIELD_S32(offset) &= (s32)(value)
 
+#ifdef DECODED_BEHAVIOR_SCRIPTS
+/**
+ * The size of the pool that decoded behavior scripts are stored in, in bytes.
+ */
+#define BEHAVIOR_DECODE_POOL_SIZE 0x8000
+
+void alloc_behavior_decode_pool(void);
+#endif
+
 void cur_obj_update(void);
 
 #endif // BEHAVIOR_SCRIPT_H
@@ -138,6 +138,9 @@ struct DisplayListNode {
     Mtx *transform;
     void *displayList;
     struct DisplayListNode *next;
+#ifdef SORT_DISPLAY_LISTS_BY_MATERIAL
+    uintptr_t materialKey;
+#endif
 };
 
 /** GraphNode that manages the 8 top-level display lists that will be drawn
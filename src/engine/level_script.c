@@ -6,6 +6,7 @@
 #include "sm64.h"
 #include "audio/external.h"
 #include "audio/synthesis.h"
+#include "behavior_script.h"
 #include "buffers/framebuffers.h"
 #include "buffers/zbuffer.h"
 #include "game/area.h"
@@ -62,6 +63,9 @@ static u16 sDelayFrames2 = 0;
 
 static s16 sCurrAreaIndex = -1;
 
+static u16 sObjectPoolCapacity = OBJECT_POOL_CAPACITY;
+static u8 sTopLevelStatePushed = FALSE;
+
 static uintptr_t *sStackTop = sStack;
 static uintptr_t *sStackBase = NULL;
 
@@ -322,10 +326,26 @@ static void level_cmd_change_area_skybox(void) {
 }
 
 static void level_cmd_init_level(void) {
+    // The entry script runs INIT_LEVEL at top level on every pass and never
+    // clears it, so drop the state the previous pass pushed.
+    if (sStackBase == NULL && sTopLevelStatePushed) {
+        main_pool_pop_state();
+    }
+    sTopLevelStatePushed = (sStackBase == NULL);
+
     init_graph_node_start(NULL, (struct GraphNodeStart *) &gObjParentGraphNode);
-    clear_objects();
-    clear_areas();
     main_pool_push_state();
+    // The entry script never spawns objects, and every level it runs inits its own pools,
+    // so only allocate them for nested levels. Allocating after the push lets CLEAR_LEVEL free them.
+    if (sStackBase != NULL) {
+        alloc_object_pool(sObjectPoolCapacity);
+        sObjectPoolCapacity = OBJECT_POOL_CAPACITY;
+#ifdef DECODED_BEHAVIOR_SCRIPTS
+        alloc_behavior_decode_pool();
+#endif
+        clear_objects();
+    }
+    clear_areas();
     for (u8 clearPointers = 0; clearPointers < AREA_COUNT; clearPointers++) {
         gAreaSkyboxStart[clearPointers] = 0;
         gAreaSkyboxEnd[clearPointers] = 0;
@@ -662,6 +682,17 @@ static void level_cmd_set_rooms(void) {
     sCurrentCmd = CMD_NEXT;
 }
 
+static void level_cmd_set_room_visibility(void) {
+#ifdef ROOM_VISIBILITY_CULLING
+    if (sCurrAreaIndex != -1) {
+        // Rooms past the ones a RoomVisibility mask has bits for are treated as always visible.
+        gAreas[sCurrAreaIndex].numVisibilityRooms = MIN(CMD_GET(s16, 2), ROOM_VISIBILITY_WORDS * 32);
+        gAreas[sCurrAreaIndex].roomVisibility = segmented_to_virtual(CMD_GET(void *, 4));
+    }
+#endif
+    sCurrentCmd = CMD_NEXT;
+}
+
 static void level_cmd_set_macro_objects(void) {
     if (sCurrAreaIndex != -1) {
 #ifndef NO_SEGMENTED_MEMORY
@@ -871,6 +902,12 @@ static void level_cmd_set_echo(void) {
     sCurrentCmd = CMD_NEXT;
 }
 
+static void level_cmd_set_object_pool_size(void) {
+    sObjectPoolCapacity = CMD_GET(u16, 2);
+
+    sCurrentCmd = CMD_NEXT;
+}
+
 static void (*LevelScriptJumpTable[])(void) = {
     /*LEVEL_CMD_LOAD_AND_EXECUTE            */ level_cmd_load_and_execute,
     /*LEVEL_CMD_EXIT_AND_EXECUTE            */ level_cmd_exit_and_execute,
@@ -936,6 +973,8 @@ static void (*LevelScriptJumpTable[])(void) = {
     /*LEVEL_CMD_PUPPYVOLUME                 */ level_cmd_puppyvolume,
     /*LEVEL_CMD_CHANGE_AREA_SKYBOX          */ level_cmd_change_area_skybox,
     /*LEVEL_CMD_SET_ECHO                    */ level_cmd_set_echo,
+    /*LEVEL_CMD_SET_OBJECT_POOL_SIZE        */ level_cmd_set_object_pool_size,
+    /*LEVEL_CMD_SET_ROOM_VISIBILITY         */ level_cmd_set_room_visibility,
 };
 
 struct LevelCommand *level_script_execute(struct LevelCommand *cmd) {
@@ -6,6 +6,7 @@
 #include "surface_collision.h"
 #include "trig_tables.inc.c"
 #include "surface_load.h"
+#include "game/debug.h"
 #include "game/puppyprint.h"
 #include "game/rendering_graph_node.h"
 
@@ -201,37 +202,47 @@ void mtxf_rotate_zxy_and_translate_and_mul(Vec3s rot, Vec3f trans, Mat4 dest, Ma
     MTXF_END(dest);
 }
 
-/// Build a matrix that rotates around the x axis, then the y axis, then the z axis, and then translates and multiplies.
-void mtxf_rotate_xyz_and_translate_and_mul(Vec3s rot, Vec3f trans, Mat4 dest, Mat4 src) {
-    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.matrix);
+/// Build the rotation rows of a matrix that rotates around the x axis, then the y axis, then the z axis.
+void mtxf_rotate_xyz_rows(Vec3f rows[3], Vec3s rot) {
     f32 sx = sins(rot[0]);
     f32 cx = coss(rot[0]);
     f32 sy = sins(rot[1]);
     f32 cy = coss(rot[1]);
     f32 sz = sins(rot[2]);
     f32 cz = coss(rot[2]);
-    Vec3f entry;
-    entry[0] = (cy * cz);
-    entry[1] = (cy * sz);
-    entry[2] = -sy;
-    linear_mtxf_mul_vec3f(src, dest[0], entry);
+    rows[0][0] = (cy * cz);
+    rows[0][1] = (cy * sz);
+    rows[0][2] = -sy;
     f32 sxcz = (sx * cz);
     f32 cxsz = (cx * sz);
-    entry[0] = ((sxcz * sy) - cxsz);
+    rows[1][0] = ((sxcz * sy) - cxsz);
     f32 sxsz = (sx * sz);
     f32 cxcz = (cx * cz);
-    entry[1] = ((sxsz * sy) + cxcz);
-    entry[2] = (sx * cy);
-    linear_mtxf_mul_vec3f(src, dest[1], entry);
-    entry[0] = ((cxcz * sy) + sxsz);
-    entry[1] = ((cxsz * sy) - sxcz);
-    entry[2] = (cx * cy);
-    linear_mtxf_mul_vec3f(src, dest[2], entry);
+    rows[1][1] = ((sxsz * sy) + cxcz);
+    rows[1][2] = (sx * cy);
+    rows[2][0] = ((cxcz * sy) + sxsz);
+    rows[2][1] = ((cxsz * sy) - sxcz);
+    rows[2][2] = (cx * cy);
+}
+
+/// Build a matrix from rotation rows and a translation, and then multiply it.
+void mtxf_rows_translate_and_mul(Vec3f rows[3], Vec3f trans, Mat4 dest, Mat4 src) {
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.matrix);
+    linear_mtxf_mul_vec3f(src, dest[0], rows[0]);
+    linear_mtxf_mul_vec3f(src, dest[1], rows[1]);
+    linear_mtxf_mul_vec3f(src, dest[2], rows[2]);
     linear_mtxf_mul_vec3f(src, dest[3], trans);
     vec3f_add(dest[3], src[3]);
     MTXF_END(dest);
 }
 
+/// Build a matrix that rotates around the x axis, then the y axis, then the z axis, and then translates and multiplies.
+void mtxf_rotate_xyz_and_translate_and_mul(Vec3s rot, Vec3f trans, Mat4 dest, Mat4 src) {
+    Vec3f rows[3];
+    mtxf_rotate_xyz_rows(rows, rot);
+    mtxf_rows_translate_and_mul(rows, trans, dest, src);
+}
+
 /**
  * Set mtx to a look-at matrix for the camera. The resulting transformation
  * transforms the world as if there exists a camera at position 'from' pointed
@@ -822,30 +833,24 @@ s32 anim_spline_poll(Vec3f result) {
  **************************************************/
 
 /**
- * @brief Checks if a ray intersects a surface using Möller–Trumbore intersection algorithm.
- *
- * @param orig is the starting point of the ray.
- * @param dir is the normalized ray direction.
- * @param dir_length is the length of the ray.
- * @param surface is the surface to check.
- * @param hit_pos returns the position on the surface where the ray intersects it.
- * @param length returns the distance from the starting point to the hit position.
- * @return s32 TRUE if the ray intersects a surface.
+ * @brief Gets the first vertex of a surface and the two edges leading from it, as used by ray_triangle_intersect.
  */
-s32 ray_surface_intersect(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface *surface, Vec3f hit_pos, f32 *length) {
-    // Ignore certain surface types.
-    if ((surface->type == SURFACE_INTANGIBLE) || (surface->flags & SURFACE_FLAG_NO_CAM_COLLISION)) return FALSE;
+static void get_ray_surface_edges(struct Surface *surface, Vec3f v0, Vec3f e1, Vec3f e2) {
     // Convert the vertices to Vec3f.
-    Vec3f v0, v1, v2;
+    Vec3f v1, v2;
     vec3s_to_vec3f(v0, surface->vertex1);
     vec3s_to_vec3f(v1, surface->vertex2);
     vec3s_to_vec3f(v2, surface->vertex3);
     // Make 'e1' (edge 1) the vector from vertex 0 to vertex 1.
-    Vec3f e1;
     vec3f_diff(e1, v1, v0);
     // Make 'e2' (edge 2) the vector from vertex 0 to vertex 2.
-    Vec3f e2;
     vec3f_diff(e2, v2, v0);
+}
+
+/**
+ * @brief The Möller–Trumbore intersection test used by ray_surface_intersect, given the triangle's first vertex and edges.
+ */
+static s32 ray_triangle_intersect(Vec3f orig, Vec3f dir, f32 dir_length, Vec3f v0, Vec3f e1, Vec3f e2, Vec3f hit_pos, f32 *length) {
     // Make 'h' the cross product of 'dir' and edge 2.
     Vec3f h;
     vec3f_cross(h, dir, e2);
@@ -884,6 +889,40 @@ s32 ray_surface_intersect(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface
     return TRUE;
 }
 
+/**
+ * @brief Checks if a ray intersects a surface using Möller–Trumbore intersection algorithm.
+ *
+ * @param orig is the starting point of the ray.
+ * @param dir is the normalized ray direction.
+ * @param dir_length is the length of the ray.
+ * @param surface is the surface to check.
+ * @param hit_pos returns the position on the surface where the ray intersects it.
+ * @param length returns the distance from the starting point to the hit position.
+ * @return s32 TRUE if the ray intersects a surface.
+ */
+s32 ray_surface_intersect(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface *surface, Vec3f hit_pos, f32 *length) {
+    // Ignore certain surface types.
+    if ((surface->type == SURFACE_INTANGIBLE) || (surface->flags & SURFACE_FLAG_NO_CAM_COLLISION)) return FALSE;
+    Vec3f v0, e1, e2;
+    get_ray_surface_edges(surface, v0, e1, e2);
+    return ray_triangle_intersect(orig, dir, dir_length, v0, e1, e2, hit_pos, length);
+}
+
+/**
+ * @brief Gets the vertical range a ray covers.
+ */
+static void get_ray_vertical_bounds(Vec3f orig, Vec3f dir, f32 dir_length, f32 *top, f32 *bottom) {
+    if (dir[1] >= 0.0f) {
+        // Ray is upwards.
+        *top    = orig[1] + (dir[1] * dir_length);
+        *bottom = orig[1];
+    } else {
+        // Ray is downwards.
+        *top    = orig[1];
+        *bottom = orig[1] + (dir[1] * dir_length);
+    }
+}
+
 void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length) {
     s32 hit;
     f32 length;
@@ -891,20 +930,12 @@ void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f
     f32 top, bottom;
     PUPPYPRINT_GET_SNAPSHOT();
     // Get upper and lower bounds of ray
-    if (dir[1] >= 0.0f) {
-        // Ray is upwards.
-        top    = orig[1] + (dir[1] * dir_length);
-        bottom = orig[1];
-    } else {
-        // Ray is downwards.
-        top    = orig[1];
-        bottom = orig[1] + (dir[1] * dir_length);
-    }
+    get_ray_vertical_bounds(orig, dir, dir_length, &top, &bottom);
 
     // Iterate through every surface of the list
     for (; list != NULL; list = list->next) {
         // Reject surface if out of vertical bounds
-        if ((list->surface->lowerY > top) || (list->surface->upperY < bottom)) continue;
+        if ((SURFACE_NODE_QUERY(list)->lowerY > top) || (SURFACE_NODE_QUERY(list)->upperY < bottom)) continue;
         // Check intersection between the ray and this surface
         hit = ray_surface_intersect(orig, dir, dir_length, list->surface, chk_hit_pos, &length);
         if (hit && (length <= *max_length)) {
@@ -921,38 +952,40 @@ void find_surface_on_ray_cell(s32 cellX, s32 cellZ, Vec3f orig, Vec3f normalized
     if ((cellX >= 0) && (cellX <= (NUM_CELLS - 1)) && (cellZ >= 0) && (cellZ <= (NUM_CELLS - 1))) {
         // Iterate through each surface in this partition
         if ((normalized_dir[1] > -NEAR_ONE) && (flags & RAYCAST_FIND_CEIL)) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list( STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list(DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
         if ((normalized_dir[1] <  NEAR_ONE) && (flags & RAYCAST_FIND_FLOOR)) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list( STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list(DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
         if (flags & RAYCAST_FIND_WALL) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list( STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list(DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
         if (flags & RAYCAST_FIND_WATER) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list( STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+            find_surface_on_ray_list(DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
         }
     }
 }
 
-f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec3f hit_pos, s32 flags) {
-    Vec3f normalized_dir;
-    const f32 invcell = 1.0f / CELL_SIZE;
-    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_raycast);
-
-    // Set that no surface has been hit
-    *hit_surface = NULL;
-    vec3f_sum(hit_pos, orig, dir);
+/**
+ * @brief The state of a walk through the collision cells a ray passes over.
+ */
+struct RayCellWalk {
+    f32 p_x, p_z;
+    f32 stp_x, stp_z;
+    f32 delta_x, delta_z;
+    f32 t_max_x, t_max_z;
+    u8 vertical;
+};
 
-    // Get normalized direction
-    f32 dir_length = vec3_mag(dir);
-    f32 max_length = dir_length;
-    vec3f_copy(normalized_dir, dir);
-    vec3f_normalize(normalized_dir);
+/**
+ * @brief Starts a walk through the cells a ray passes over. The first cell is (walk->p_x, walk->p_z).
+ */
+static void ray_cell_walk_init(struct RayCellWalk *walk, Vec3f orig, Vec3f dir, Vec3f normalized_dir) {
+    const f32 invcell = 1.0f / CELL_SIZE;
 
     // Get the start and end coords converted to cell-space
     f32 start_cell_coord_x = (orig[0] + LEVEL_BOUNDARY_MAX) * invcell;
@@ -961,43 +994,251 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
     f32 end_cell_coord_z   = (orig[2] + dir[2] + LEVEL_BOUNDARY_MAX) * invcell;
 
     // Don't do grid traversal if straight down
-    if ((normalized_dir[1] >= NEAR_ONE) || (normalized_dir[1] <= -NEAR_ONE)) {
-        find_surface_on_ray_cell((s32)start_cell_coord_x, (s32)start_cell_coord_z, orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
-        return max_length;
+    walk->vertical = ((normalized_dir[1] >= NEAR_ONE) || (normalized_dir[1] <= -NEAR_ONE));
+    if (walk->vertical) {
+        walk->p_x = (s32)start_cell_coord_x;
+        walk->p_z = (s32)start_cell_coord_z;
+        return;
     }
 
     // "A Fast Voxel Traversal Algorithm for Ray Tracing" - John Amanatides & Andrew Woo
     // Adapted from implementation at https://www.shadertoy.com/view/XddcWn
     f32 rd_x = end_cell_coord_x - start_cell_coord_x;
     f32 rd_z = end_cell_coord_z - start_cell_coord_z;
-    f32 p_x = (s32)start_cell_coord_x;
-    f32 p_z = (s32)start_cell_coord_z;
+    walk->p_x = (s32)start_cell_coord_x;
+    walk->p_z = (s32)start_cell_coord_z;
     f32 rdinv_x = 1.0f / rd_x;
     f32 rdinv_z = 1.0f / rd_z;
-    f32 stp_x = signum_positive(rd_x);
-    f32 stp_z = signum_positive(rd_z);
-    f32 delta_x = MIN(rdinv_x * stp_x, 1.0f);
-    f32 delta_z = MIN(rdinv_z * stp_z, 1.0f);
-    f32 t_max_x = ABS((p_x + MAX(stp_x, 0.0f) - start_cell_coord_x) * rdinv_x);
-    f32 t_max_z = ABS((p_z + MAX(stp_z, 0.0f) - start_cell_coord_z) * rdinv_z);
-
-    while (TRUE) {
-        find_surface_on_ray_cell((s32)p_x, (s32)p_z, orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
-        f32 t_next = MIN(t_max_x, t_max_z);
-        if (t_next > 1.0f) {
-            break;
+    walk->stp_x = signum_positive(rd_x);
+    walk->stp_z = signum_positive(rd_z);
+    walk->delta_x = MIN(rdinv_x * walk->stp_x, 1.0f);
+    walk->delta_z = MIN(rdinv_z * walk->stp_z, 1.0f);
+    walk->t_max_x = ABS((walk->p_x + MAX(walk->stp_x, 0.0f) - start_cell_coord_x) * rdinv_x);
+    walk->t_max_z = ABS((walk->p_z + MAX(walk->stp_z, 0.0f) - start_cell_coord_z) * rdinv_z);
+}
+
+/**
+ * @brief Steps to the next cell the ray passes over. Returns FALSE once the ray has ended.
+ */
+static s32 ray_cell_walk_next(struct RayCellWalk *walk) {
+    if (walk->vertical || (MIN(walk->t_max_x, walk->t_max_z) > 1.0f)) {
+        return FALSE;
+    }
+
+    if (walk->t_max_x < walk->t_max_z) {
+        walk->t_max_x += walk->delta_x;
+        walk->p_x += walk->stp_x;
+    }
+    else {
+        walk->t_max_z += walk->delta_z;
+        walk->p_z += walk->stp_z;
+    }
+
+    return TRUE;
+}
+
+f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec3f hit_pos, s32 flags) {
+    Vec3f normalized_dir;
+    struct RayCellWalk walk;
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_raycast);
+
+    // Set that no surface has been hit
+    *hit_surface = NULL;
+    vec3f_sum(hit_pos, orig, dir);
+
+    // Get normalized direction
+    f32 dir_length = vec3_mag(dir);
+    f32 max_length = dir_length;
+    vec3f_copy(normalized_dir, dir);
+    vec3f_normalize(normalized_dir);
+
+    s32 cellX, cellZ;
+    s32 prevCellX = -1;
+    s32 prevCellZ = -1;
+
+    ray_cell_walk_init(&walk, orig, dir, normalized_dir);
+    do {
+        cellX = (s32)walk.p_x;
+        cellZ = (s32)walk.p_z;
+        if ((cellX >= 0) && (cellX <= (NUM_CELLS - 1)) && (cellZ >= 0) && (cellZ <= (NUM_CELLS - 1))) {
+            get_partition_cell_owner(cellZ, cellX);
+        }
+
+        // Skip cells that share their lists with the cell just checked.
+        if ((cellX != prevCellX) || (cellZ != prevCellZ)) {
+            find_surface_on_ray_cell(cellX, cellZ, orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
+            prevCellX = cellX;
+            prevCellZ = cellZ;
+        }
+    } while (ray_cell_walk_next(&walk));
+
+    return max_length;
+}
+
+/**
+ * @brief A bundle of rays being cast together by find_surfaces_on_rays.
+ */
+struct RayBatch {
+    Vec3f *orig;
+    Vec3f dir[RAY_BATCH_MAX_RAYS]; // Normalized
+    f32 length[RAY_BATCH_MAX_RAYS];
+    f32 top[RAY_BATCH_MAX_RAYS];
+    f32 bottom[RAY_BATCH_MAX_RAYS];
+    u8 listMasks[NUM_SPATIAL_PARTITIONS]; // The rays that check each kind of surface list.
+    struct {
+        s16 x, z;
+        u8 rayMask;
+    } cells[RAY_BATCH_MAX_CELLS];
+    s32 numCells;
+    // Results
+    struct Surface **hit_surface;
+    Vec3f *hit_pos;
+    f32 *max_length;
+};
+
+static void find_surfaces_on_ray_list_batch(struct SurfaceNode *list, struct RayBatch *batch, u32 rayMask) {
+    Vec3f v0, e1, e2;
+    Vec3f chk_hit_pos;
+    f32 length;
+    u32 i, mask;
+    PUPPYPRINT_GET_SNAPSHOT();
+
+    // Iterate through every surface of the list
+    for (; list != NULL; list = list->next) {
+        SurfaceQuery *query = SURFACE_NODE_QUERY(list);
+
+        // Find the rays this surface is within the vertical bounds of
+        mask = 0;
+        for (i = 0; (rayMask >> i) != 0; i++) {
+            if (((rayMask >> i) & 1) && (query->lowerY <= batch->top[i]) && (query->upperY >= batch->bottom[i])) {
+                mask |= (1 << i);
+            }
         }
+        if (mask == 0) continue;
+
+        // Ignore certain surface types.
+        struct Surface *surf = list->surface;
+        if ((surf->type == SURFACE_INTANGIBLE) || (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION)) continue;
+
+        // Load the surface once, then check it against every ray
+        get_ray_surface_edges(surf, v0, e1, e2);
+        for (i = 0; (mask >> i) != 0; i++) {
+            if (((mask >> i) & 1)
+                && ray_triangle_intersect(batch->orig[i], batch->dir[i], batch->length[i], v0, e1, e2, chk_hit_pos, &length)
+                && (length <= batch->max_length[i])) {
+                batch->hit_surface[i] = surf;
+                vec3f_copy(batch->hit_pos[i], chk_hit_pos);
+                batch->max_length[i] = length;
+            }
+        }
+    }
+    profiler_collision_update(first);
+}
+
+/**
+ * @brief Checks every cell gathered so far against the rays that pass over it, then empties the cell list.
+ */
+static void find_surfaces_on_ray_batch_cells(struct RayBatch *batch) {
+    for (s32 i = 0; i < batch->numCells; i++) {
+        s32 cellX = batch->cells[i].x;
+        s32 cellZ = batch->cells[i].z;
 
-        if (t_max_x < t_max_z) {
-            t_max_x += delta_x;
-            p_x += stp_x;
+        for (s32 listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+            u32 rayMask = (batch->cells[i].rayMask & batch->listMasks[listIndex]);
+
+            if (rayMask != 0) {
+                find_surfaces_on_ray_list_batch( STATIC_PARTITION_CELL(cellZ, cellX)[listIndex], batch, rayMask);
+                find_surfaces_on_ray_list_batch(DYNAMIC_PARTITION_CELL(cellZ, cellX)[listIndex], batch, rayMask);
+            }
         }
-        else {
-            t_max_z += delta_z;
-            p_z += stp_z;
+    }
+
+    batch->numCells = 0;
+}
+
+static void add_ray_batch_cell(struct RayBatch *batch, s32 cellX, s32 cellZ, s32 ray) {
+    s32 i;
+
+    // Skip if OOB
+    if ((cellX < 0) || (cellX > (NUM_CELLS - 1)) || (cellZ < 0) || (cellZ > (NUM_CELLS - 1))) {
+        return;
+    }
+
+    // Cells that share their lists are gathered as one.
+    get_partition_cell_owner(cellZ, cellX);
+
+    for (i = 0; i < batch->numCells; i++) {
+        if ((batch->cells[i].x == cellX) && (batch->cells[i].z == cellZ)) {
+            batch->cells[i].rayMask |= (1 << ray);
+            return;
         }
     }
-    return max_length;
+
+    // Out of room, so check the cells gathered so far and start over.
+    if (batch->numCells == RAY_BATCH_MAX_CELLS) {
+        find_surfaces_on_ray_batch_cells(batch);
+    }
+
+    batch->cells[batch->numCells].x = cellX;
+    batch->cells[batch->numCells].z = cellZ;
+    batch->cells[batch->numCells].rayMask = (1 << ray);
+    batch->numCells++;
+}
+
+/**
+ * @brief Casts a bundle of rays at once. Each cell any of the rays pass over is visited once,
+ * and each surface in it is loaded once and checked against every ray passing over that cell.
+ * Gives the same results as calling find_surface_on_ray for each ray with the same flags, except
+ * which surface is returned when a ray hits two at exactly the same distance.
+ *
+ * @param numRays is the number of rays, up to RAY_BATCH_MAX_RAYS.
+ * @param orig is the starting point of each ray.
+ * @param dir is the direction and length of each ray.
+ * @param hit_surface returns the surface each ray hit, or NULL.
+ * @param hit_pos returns the position each ray hit, or the end of the ray.
+ * @param hit_length returns the distance to each ray's hit, or the length of the ray.
+ * @param flags are the kinds of surfaces to check.
+ */
+void find_surfaces_on_rays(s32 numRays, Vec3f *orig, Vec3f *dir, struct Surface **hit_surface, Vec3f *hit_pos, f32 *hit_length, s32 flags) {
+    struct RayBatch batch;
+    struct RayCellWalk walk;
+    s32 i;
+
+    assert(numRays <= RAY_BATCH_MAX_RAYS, "Too many rays in one batch");
+
+    batch.orig = orig;
+    batch.hit_surface = hit_surface;
+    batch.hit_pos = hit_pos;
+    batch.max_length = hit_length;
+    batch.numCells = 0;
+    bzero(batch.listMasks, sizeof(batch.listMasks));
+
+    for (i = 0; i < numRays; i++) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_raycast);
+
+        // Set that no surface has been hit
+        hit_surface[i] = NULL;
+        vec3f_sum(hit_pos[i], orig[i], dir[i]);
+
+        // Get normalized direction
+        batch.length[i] = vec3_mag(dir[i]);
+        hit_length[i] = batch.length[i];
+        vec3f_copy(batch.dir[i], dir[i]);
+        vec3f_normalize(batch.dir[i]);
+        get_ray_vertical_bounds(orig[i], batch.dir[i], batch.length[i], &batch.top[i], &batch.bottom[i]);
+
+        if ((batch.dir[i][1] > -NEAR_ONE) && (flags & RAYCAST_FIND_CEIL )) batch.listMasks[SPATIAL_PARTITION_CEILS ] |= (1 << i);
+        if ((batch.dir[i][1] <  NEAR_ONE) && (flags & RAYCAST_FIND_FLOOR)) batch.listMasks[SPATIAL_PARTITION_FLOORS] |= (1 << i);
+        if (flags & RAYCAST_FIND_WALL ) batch.listMasks[SPATIAL_PARTITION_WALLS] |= (1 << i);
+        if (flags & RAYCAST_FIND_WATER) batch.listMasks[SPATIAL_PARTITION_WATER] |= (1 << i);
+
+        ray_cell_walk_init(&walk, orig[i], dir[i], batch.dir[i]);
+        do {
+            add_ray_batch_cell(&batch, (s32)walk.p_x, (s32)walk.p_z, i);
+        } while (ray_cell_walk_next(&walk));
+    }
+
+    find_surfaces_on_ray_batch_cells(&batch);
 }
 
 // Constructs a float in registers, which can be faster than gcc's default of loading a float from rodata.
@@ -634,6 +634,8 @@ void mtxf_lookat(Mat4 mtx, Vec3f from, Vec3f to, s16 roll);
 void mtxf_rotate_zxy_and_translate(Mat4 dest, Vec3f trans, Vec3s rot);
 void mtxf_rotate_xyz_and_translate(Mat4 dest, Vec3f trans, Vec3s rot);
 void mtxf_rotate_zxy_and_translate_and_mul(Vec3s rot, Vec3f trans, Mat4 dest, Mat4 src);
+void mtxf_rotate_xyz_rows(Vec3f rows[3], Vec3s rot);
+void mtxf_rows_translate_and_mul(Vec3f rows[3], Vec3f trans, Mat4 dest, Mat4 src);
 void mtxf_rotate_xyz_and_translate_and_mul(Vec3s rot, Vec3f trans, Mat4 dest, Mat4 src);
 void mtxf_billboard(Mat4 dest, Mat4 mtx, Vec3f position, Vec3f scale, s16 angle);
 void mtxf_shadow(Mat4 dest, Vec3f upDir, Vec3f pos, Vec3f scale, s16 yaw);
@@ -678,6 +680,12 @@ void anim_spline_init(Vec4s *keyFrames);
 s32  anim_spline_poll(Vec3f result);
 f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec3f hit_pos, s32 flags);
 
+// The most rays find_surfaces_on_rays can cast at once.
+#define RAY_BATCH_MAX_RAYS  8
+// The most cells find_surfaces_on_rays gathers before checking them.
+#define RAY_BATCH_MAX_CELLS 64
+void find_surfaces_on_rays(s32 numRays, Vec3f *orig, Vec3f *dir, struct Surface **hit_surface, Vec3f *hit_pos, f32 *hit_length, s32 flags);
+
 ALWAYS_INLINE f32 remap(f32 x, f32 fromA, f32 toA, f32 fromB, f32 toB) {
     return (x - fromA) / (toA - fromA) * (toB - fromB) + fromB;
 }
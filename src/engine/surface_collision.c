@@ -10,6 +10,68 @@
 #include "surface_load.h"
 #include "game/puppyprint.h"
 
+/**************************************************
+ *                  QUERY CACHE                   *
+ **************************************************/
+
+#ifdef COLLISION_QUERY_CACHE
+// Must be powers of two.
+#define FLOOR_QUERY_CACHE_SIZE 64
+#define CEIL_QUERY_CACHE_SIZE  32
+
+// The collision flags that can change the result of a floor or ceiling query.
+#define COLLISION_QUERY_CACHE_FLAGS (COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_CAMERA | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE)
+
+struct CollisionQueryCacheEntry {
+    s32 x, y, z;
+    u32 generation;
+    s16 flags;
+    struct Surface *surface;
+    f32 height;
+};
+
+static struct CollisionQueryCacheEntry sFloorQueryCache[FLOOR_QUERY_CACHE_SIZE];
+static struct CollisionQueryCacheEntry sCeilQueryCache[CEIL_QUERY_CACHE_SIZE];
+
+/**
+ * Entries from an older generation are stale. Starts at 1 so zeroed entries are never valid.
+ */
+static u32 sCollisionQueryCacheGeneration = 1;
+
+/**
+ * Forget every cached query. Called whenever surfaces are loaded or cleared.
+ */
+void invalidate_collision_query_cache(void) {
+    sCollisionQueryCacheGeneration++;
+}
+
+/**
+ * Get the cache slot for a query. If it holds the same query, *hit is set and its result can be used.
+ */
+static struct CollisionQueryCacheEntry *get_collision_query_cache_entry(struct CollisionQueryCacheEntry *cache, u32 size, s32 x, s32 y, s32 z, s32 *hit) {
+    s16 flags = (gCollisionFlags & COLLISION_QUERY_CACHE_FLAGS);
+    u32 index = (((x * 73856093) ^ (y * 19349663) ^ (z * 83492791) ^ flags) & (size - 1));
+    struct CollisionQueryCacheEntry *entry = &cache[index];
+
+    *hit = (entry->generation == sCollisionQueryCacheGeneration
+            && entry->x == x && entry->y == y && entry->z == z
+            && entry->flags == flags);
+
+    if (*hit) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_cache_hit);
+    } else {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_cache_miss);
+        entry->x = x;
+        entry->y = y;
+        entry->z = z;
+        entry->flags = flags;
+        entry->generation = 0;
+    }
+
+    return entry;
+}
+#endif
+
 /**************************************************
  *                      WALLS                     *
  **************************************************/
@@ -53,6 +115,7 @@ s32 check_wall_edge(Vec3f vert, Vec3f v2, f32 *d00, f32 *d01, f32 *invDenom, f32
 static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struct WallCollisionData *data) {
     const f32 corner_threshold = -0.9f;
     struct Surface *surf;
+    SurfaceQuery *query;
     f32 offset;
     f32 radius = data->radius;
 
@@ -67,12 +130,23 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struc
 
     // Stay in this loop until out of walls.
     while (surfaceNode != NULL) {
+        query       = SURFACE_NODE_QUERY(surfaceNode);
         surf        = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
-        type        = surf->type;
 
         // Exclude a large number of walls immediately to optimize.
-        if (pos[1] < surf->lowerY || pos[1] > surf->upperY) continue;
+        if (pos[1] < query->lowerY || pos[1] > query->upperY) continue;
+
+        // Dot of normal and pos, + origin offset
+        offset = (query->normal.x * pos[0])
+               + (query->normal.y * pos[1])
+               + (query->normal.z * pos[2])
+               + query->originOffset;
+
+        // Exclude surfaces outside of the radius.
+        if (offset < -radius || offset > radius) continue;
+
+        type = surf->type;
 
         // Determine if checking for the camera or not.
         if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
@@ -90,15 +164,6 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struc
             }
         }
 
-        // Dot of normal and pos, + origin offset
-        offset = (surf->normal.x * pos[0])
-               + (surf->normal.y * pos[1])
-               + (surf->normal.z * pos[2])
-               + surf->originOffset;
-
-        // Exclude surfaces outside of the radius.
-        if (offset < -radius || offset > radius) continue;
-
         vec3_diff(v0, surf->vertex2, surf->vertex1);
         vec3_diff(v1, surf->vertex3, surf->vertex1);
         vec3_diff(v2, pos,           surf->vertex1);
@@ -218,14 +283,17 @@ s32 find_wall_collisions(struct WallCollisionData *colData) {
 
     for (s32 cellX = minCellX; cellX <= maxCellX; cellX++) {
         for (s32 cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            // Don't check the same walls twice when neighboring cells share them.
+            if (PARTITION_CELL_IS_REPEAT(cellZ, cellX, minCellZ, minCellX)) continue;
+
             if (!(gCollisionFlags & COLLISION_FLAG_EXCLUDE_DYNAMIC)) {
                 // Check for surfaces belonging to objects.
-                node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS];
+                node = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS];
                 numCollisions += find_wall_collisions_from_list(node, colData);
             }
 
             // Check for surfaces that are a part of level geometry.
-            node = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS];
+            node = STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS];
             numCollisions += find_wall_collisions_from_list(node, colData);
         }
     }
@@ -295,38 +363,64 @@ static s32 check_within_ceil_triangle_bounds(s32 x, s32 z, struct Surface *surf,
     return TRUE;
 }
 
+#ifdef SURFACE_EDGE_FUNCTIONS
+// Evaluate one of a surface's precomputed lateral edge equations at a point.
+#define surface_edge_function(query, i, x, z) (((query)->edgeX[i] * (x)) + ((query)->edgeZ[i] * (z)) + (query)->edgeOffset[i])
+
+// Get the height of a surface at a point, multiplying by the precomputed reciprocal of normal.y instead of dividing.
+#define get_query_height_at_location(xPos, zPos, query) (-(((xPos) * (query)->normal.x) + ((zPos) * (query)->normal.z) + (query)->originOffset) * (query)->invNormalY)
+
+static s32 check_within_ceil_query_bounds(s32 x, s32 z, SurfaceQuery *query) {
+    // Checking if point is in bounds of the triangle laterally.
+    if (surface_edge_function(query, 0, x, z) > 0) return FALSE;
+    if (surface_edge_function(query, 1, x, z) > 0) return FALSE;
+    if (surface_edge_function(query, 2, x, z) > 0) return FALSE;
+
+    return TRUE;
+}
+#elif defined(SURFACE_QUERY_RECORDS)
+static s32 check_within_ceil_query_bounds(s32 x, s32 z, struct SurfaceQueryRecord *query) {
+    TerrainData *vx = query->vertexX;
+    TerrainData *vz = query->vertexZ;
+
+    // Checking if point is in bounds of the triangle laterally.
+    if (((vz[0] - z) * (vx[1] - vx[0]) - (vx[0] - x) * (vz[1] - vz[0])) > 0) return FALSE;
+    if (((vz[1] - z) * (vx[2] - vx[1]) - (vx[1] - x) * (vz[2] - vz[1])) > 0) return FALSE;
+    if (((vz[2] - z) * (vx[0] - vx[2]) - (vx[2] - x) * (vz[0] - vz[2])) > 0) return FALSE;
+
+    return TRUE;
+}
+#else
+#define check_within_ceil_query_bounds(x, z, surf) check_within_ceil_triangle_bounds((x), (z), (surf), 1.5f)
+#endif
+
+#ifndef SURFACE_EDGE_FUNCTIONS
+#define get_query_height_at_location(xPos, zPos, query) get_surface_height_at_location((xPos), (zPos), (query))
+#endif
+
 /**
  * Iterate through the list of ceilings and find the first ceiling over a given point.
  */
 static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, s32 x, s32 y, s32 z, f32 *pheight) {
     register struct Surface *surf, *ceil = NULL;
+    register SurfaceQuery *query;
     register f32 height;
     SurfaceType type = SURFACE_DEFAULT;
     *pheight = CELL_HEIGHT_LIMIT;
     // Stay in this loop until out of ceilings.
     while (surfaceNode != NULL) {
+        query = SURFACE_NODE_QUERY(surfaceNode);
         surf = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
-        type = surf->type;
 
         // Exclude all ceilings below the point
-        if (y > surf->upperY) continue;
-
-        // Determine if checking for the camera or not
-        if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
-            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
-                continue;
-            }
-        } else if (type == SURFACE_CAMERA_BOUNDARY) {
-            // Ignore camera only surfaces
-            continue;
-        }
+        if (y > query->upperY) continue;
 
         // Check that the point is within the triangle bounds
-        if (!check_within_ceil_triangle_bounds(x, z, surf, 1.5f)) continue;
+        if (!check_within_ceil_query_bounds(x, z, query)) continue;
 
         // Find the height of the ceil at the given location
-        height = get_surface_height_at_location(x, z, surf);
+        height = get_query_height_at_location(x, z, query);
 
         // Exclude ceilings above the previous lowest ceiling
         if (height > *pheight) continue;
@@ -334,6 +428,18 @@ static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, s32
         // Checks for ceiling interaction
         if (y > height) continue;
 
+        type = surf->type;
+
+        // Determine if checking for the camera or not
+        if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
+            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
+                continue;
+            }
+        } else if (type == SURFACE_CAMERA_BOUNDARY) {
+            // Ignore camera only surfaces
+            continue;
+        }
+
 
         // Use the current ceiling
         *pheight = height;
@@ -364,6 +470,17 @@ f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil) {
         return height;
     }
 
+#ifdef COLLISION_QUERY_CACHE
+    s32 cacheHit;
+    struct CollisionQueryCacheEntry *cacheEntry = get_collision_query_cache_entry(sCeilQueryCache, CEIL_QUERY_CACHE_SIZE, x, y, z, &cacheHit);
+    if (cacheHit) {
+        gCollisionFlags &= ~(COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
+        *pceil = cacheEntry->surface;
+        profiler_collision_update(first);
+        return cacheEntry->height;
+    }
+#endif
+
     // Each level is split into cells to limit load, find the appropriate cell.
     s32 cellX = GET_CELL_COORD(x);
     s32 cellZ = GET_CELL_COORD(z);
@@ -376,7 +493,7 @@ f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil) {
 
     if (includeDynamic) {
         // Check for surfaces belonging to objects.
-        surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS];
+        surfaceList = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS];
         dynamicCeil = find_ceil_from_list(surfaceList, x, y, z, &dynamicHeight);
 
         // In the next check, only check for ceilings lower than the previous check.
@@ -384,7 +501,7 @@ f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil) {
     }
 
     // Check for surfaces that are a part of level geometry.
-    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS];
+    surfaceList = STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS];
     ceil = find_ceil_from_list(surfaceList, x, y, z, &height);
 
     // Use the lower ceiling.
@@ -396,6 +513,12 @@ f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil) {
     // To prevent accidentally leaving the floor tangible, stop checking for it.
     gCollisionFlags &= ~(COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
 
+#ifdef COLLISION_QUERY_CACHE
+    cacheEntry->surface = ceil;
+    cacheEntry->height = height;
+    cacheEntry->generation = sCollisionQueryCacheGeneration;
+#endif
+
     // Return the ceiling.
     *pceil = ceil;
 #ifdef VANILLA_DEBUG
@@ -428,20 +551,58 @@ static s32 check_within_floor_triangle_bounds(s32 x, s32 z, struct Surface *surf
     return TRUE;
 }
 
+#ifdef SURFACE_EDGE_FUNCTIONS
+static s32 check_within_floor_query_bounds(s32 x, s32 z, SurfaceQuery *query) {
+    if (surface_edge_function(query, 0, x, z) < 0) return FALSE;
+    if (surface_edge_function(query, 1, x, z) < 0) return FALSE;
+    if (surface_edge_function(query, 2, x, z) < 0) return FALSE;
+    return TRUE;
+}
+#elif defined(SURFACE_QUERY_RECORDS)
+static s32 check_within_floor_query_bounds(s32 x, s32 z, struct SurfaceQueryRecord *query) {
+    TerrainData *vx = query->vertexX;
+    TerrainData *vz = query->vertexZ;
+
+    if (((vz[0] - z) * (vx[1] - vx[0]) - (vx[0] - x) * (vz[1] - vz[0])) < 0) return FALSE;
+    if (((vz[1] - z) * (vx[2] - vx[1]) - (vx[1] - x) * (vz[2] - vz[1])) < 0) return FALSE;
+    if (((vz[2] - z) * (vx[0] - vx[2]) - (vx[2] - x) * (vz[0] - vz[2])) < 0) return FALSE;
+    return TRUE;
+}
+#else
+#define check_within_floor_query_bounds(x, z, surf) check_within_floor_triangle_bounds((x), (z), (surf))
+#endif
+
 /**
  * Iterate through the list of floors and find the first floor under a given point.
  */
 static struct Surface *find_floor_from_list(struct SurfaceNode *surfaceNode, s32 x, s32 y, s32 z, f32 *pheight) {
     register struct Surface *surf, *floor = NULL;
+    register SurfaceQuery *query;
     register SurfaceType type = SURFACE_DEFAULT;
     register f32 height;
     register s32 bufferY = y + FIND_FLOOR_BUFFER;
 
     // Iterate through the list of floors until there are no more floors.
     while (surfaceNode != NULL) {
+        query = SURFACE_NODE_QUERY(surfaceNode);
         surf = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
-        type        = surf->type;
+
+        // Exclude all floors above the point.
+        if (bufferY < query->lowerY) continue;
+        // Check that the point is within the triangle bounds.
+        if (!check_within_floor_query_bounds(x, z, query)) continue;
+
+        // Get the height of the floor under the current location.
+        height = get_query_height_at_location(x, z, query);
+
+        // Exclude floors lower than the previous highest floor.
+        if (height <= *pheight) continue;
+
+        // Checks for floor interaction with a FIND_FLOOR_BUFFER unit buffer.
+        if (bufferY < height) continue;
+
+        type = surf->type;
 
         // To prevent the Merry-Go-Round room from loading when Mario passes above the hole that leads
         // there, SURFACE_INTANGIBLE is used. This prevent the wrong room from loading, but can also allow
@@ -459,20 +620,6 @@ static struct Surface *find_floor_from_list(struct SurfaceNode *surfaceNode, s32
             continue; // If we are not checking for the camera, ignore camera only floors.
         }
 
-        // Exclude all floors above the point.
-        if (bufferY < surf->lowerY) continue;
-        // Check that the point is within the triangle bounds.
-        if (!check_within_floor_triangle_bounds(x, z, surf)) continue;
-
-        // Get the height of the floor under the current location.
-        height = get_surface_height_at_location(x, z, surf);
-
-        // Exclude floors lower than the previous highest floor.
-        if (height <= *pheight) continue;
-
-        // Checks for floor interaction with a FIND_FLOOR_BUFFER unit buffer.
-        if (bufferY < height) continue;
-
         // Use the current floor
         *pheight = height;
         floor = surf;
@@ -573,7 +720,7 @@ f32 unused_find_dynamic_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfl
     s32 cellX = GET_CELL_COORD(x);
     s32 cellZ = GET_CELL_COORD(z);
 
-    struct SurfaceNode *surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS];
+    struct SurfaceNode *surfaceList = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS];
 
     *pfloor = find_floor_from_list(surfaceList, x, y, z, &floorHeight);
 
@@ -603,6 +750,20 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
         profiler_collision_update(first);
         return height;
     }
+#ifdef COLLISION_QUERY_CACHE
+    s32 cacheHit;
+    struct CollisionQueryCacheEntry *cacheEntry = get_collision_query_cache_entry(sFloorQueryCache, FLOOR_QUERY_CACHE_SIZE, x, y, z, &cacheHit);
+    if (cacheHit) {
+        gCollisionFlags &= ~(COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
+        if (cacheEntry->surface == NULL) {
+            gNumFindFloorMisses++;
+        }
+        *pfloor = cacheEntry->surface;
+        profiler_collision_update(first);
+        return cacheEntry->height;
+    }
+#endif
+
     // Each level is split into cells to limit load, find the appropriate cell.
     s32 cellX = GET_CELL_COORD(x);
     s32 cellZ = GET_CELL_COORD(z);
@@ -615,7 +776,7 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
 
     if (includeDynamic) {
         // Check for surfaces belonging to objects.
-        surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS];
+        surfaceList = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS];
         dynamicFloor = find_floor_from_list(surfaceList, x, y, z, &dynamicHeight);
 
         // In the next check, only check for floors higher than the previous check.
@@ -623,7 +784,7 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
     }
 
     // Check for surfaces that are a part of level geometry.
-    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS];
+    surfaceList = STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS];
     floor = find_floor_from_list(surfaceList, x, y, z, &height);
 
     // Use the higher floor.
@@ -639,6 +800,12 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
         gNumFindFloorMisses++;
     }
 
+#ifdef COLLISION_QUERY_CACHE
+    cacheEntry->surface = floor;
+    cacheEntry->height = height;
+    cacheEntry->generation = sCollisionQueryCacheGeneration;
+#endif
+
     // Return the floor.
     *pfloor = floor;
 #ifdef VANILLA_DEBUG
@@ -690,7 +857,7 @@ f32 find_water_floor(s32 xPos, s32 yPos, s32 zPos, struct Surface **pfloor) {
     s32 cellZ = GET_CELL_COORD(z);
 
     // Check for surfaces that are a part of level geometry.
-    struct SurfaceNode *surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER];
+    struct SurfaceNode *surfaceList = STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WATER];
     struct Surface     *floor       = find_water_floor_from_list(surfaceList, x, y, z, &height);
 
     if (floor == NULL) {
@@ -856,22 +1023,22 @@ void debug_surface_list_info(f32 xPos, f32 zPos) {
     s32 cellX = GET_CELL_COORD(xPos);
     s32 cellZ = GET_CELL_COORD(zPos);
 
-    list = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS];
+    list = STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS];
     numFloors += surface_list_length(list);
 
-    list = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS];
+    list = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS];
     numFloors += surface_list_length(list);
 
-    list = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS];
+    list = STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS];
     numWalls += surface_list_length(list);
 
-    list = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS];
+    list = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS];
     numWalls += surface_list_length(list);
 
-    list = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS];
+    list = STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS];
     numCeils += surface_list_length(list);
 
-    list = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS];
+    list = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS];
     numCeils += surface_list_length(list);
 
     print_debug_top_down_mapinfo("area   %x", cellZ * NUM_CELLS + cellX);
@@ -52,6 +52,12 @@ ALWAYS_INLINE f32 find_mario_ceil(Vec3f pos, f32 height, struct Surface **ceil)
     return find_ceil(pos[0], MAX(height, pos[1]) + 3.0f, pos[2], ceil);
 }
 
+#ifdef COLLISION_QUERY_CACHE
+void invalidate_collision_query_cache(void);
+#else
+#define invalidate_collision_query_cache()
+#endif
+
 f32 find_floor_height(f32 x, f32 y, f32 z);
 f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor);
 f32 find_room_floor(f32 x, f32 y, f32 z, struct Surface **pfloor);
@@ -1,4 +1,5 @@
 #include <PR/ultratypes.h>
+#include <string.h>
 
 #include "sm64.h"
 #include "game/ingame_menu.h"
@@ -22,8 +23,13 @@
  * Partitions for course and object surfaces. The arrays represent
  * the 16x16 cells that each level is split into.
  */
+#ifdef SPARSE_SURFACE_PARTITION
+struct SparsePartitionCell gStaticSurfacePartition[NUM_COARSE_CELLS][NUM_COARSE_CELLS];
+struct SparsePartitionCell gDynamicSurfacePartition[NUM_COARSE_CELLS][NUM_COARSE_CELLS];
+#else
 SpatialPartitionCell gStaticSurfacePartition[NUM_CELLS][NUM_CELLS];
 SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
+#endif
 struct CellCoords {
     u8 z;
     u8 x;
@@ -33,6 +39,45 @@ struct CellCoords sCellsUsed[NUM_CELLS];
 u16 sNumCellsUsed;
 u8 sClearAllCells;
 
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * A block of the dynamic surface pool holding one object's surfaces and surface nodes,
+ * kept between frames for as long as the object keeps loading the same collision.
+ */
+struct DynamicSurfaceBlock {
+    Mat4 transform; // The scaled transform the surfaces were built with.
+    const BehaviorScript *behavior;
+    void *collisionData;
+    u32 capacity; // Bytes available for surface data after this header.
+    u32 used;     // Bytes of surface data currently in use.
+    u16 numSurfaces;
+    u16 numNodes;
+    u8 minCellX, maxCellX;
+    u8 minCellZ, maxCellZ;
+    u8 loaded; // Whether the object loaded its collision this frame.
+};
+
+/**
+ * Each object's block in the dynamic surface pool, indexed by the object's slot in the object pool.
+ */
+static struct DynamicSurfaceBlock *sDynamicSurfaceBlocks[OBJECT_POOL_MAX_CAPACITY];
+
+/**
+ * The amount of the dynamic surface pool taken up by blocks that are no longer in use.
+ */
+static u32 sDynamicSurfacePoolWaste;
+static u8 sResetDynamicSurfaces;
+
+/**
+ * Forget every object's block, so the dynamic surface pool is rebuilt from scratch on the next clear.
+ */
+static void reset_dynamic_surface_blocks(void) {
+    bzero(sDynamicSurfaceBlocks, sizeof(sDynamicSurfaceBlocks));
+    sDynamicSurfacePoolWaste = 0;
+    sResetDynamicSurfaces = TRUE;
+}
+#endif
+
 /**
  * Pools of data that can contain either surface nodes or surfaces.
  * The static surface pool is resized to be exactly the amount of memory needed for the level geometry.
@@ -67,6 +112,36 @@ static struct SurfaceNode *alloc_surface_node(u32 dynamic) {
     return node;
 }
 
+#ifdef SURFACE_QUERY_RECORDS
+/**
+ * Point a surface node at a surface, copying the fields used by collision checks into the node.
+ */
+static void set_surface_node(struct SurfaceNode *node, struct Surface *surface) {
+    struct SurfaceQueryRecord *query = &node->query;
+
+    node->surface = surface;
+
+    query->lowerY = surface->lowerY;
+    query->upperY = surface->upperY;
+    query->normal = surface->normal;
+    query->originOffset = surface->originOffset;
+    query->vertexX[0] = surface->vertex1[0];
+    query->vertexX[1] = surface->vertex2[0];
+    query->vertexX[2] = surface->vertex3[0];
+    query->vertexZ[0] = surface->vertex1[2];
+    query->vertexZ[1] = surface->vertex2[2];
+    query->vertexZ[2] = surface->vertex3[2];
+#ifdef SURFACE_EDGE_FUNCTIONS
+    vec3i_copy(query->edgeX, surface->edgeX);
+    vec3i_copy(query->edgeZ, surface->edgeZ);
+    vec3i_copy(query->edgeOffset, surface->edgeOffset);
+    query->invNormalY = surface->invNormalY;
+#endif
+}
+#else
+#define set_surface_node(node, surf) ((node)->surface = (surf))
+#endif
+
 /**
  * Allocate the part of the surface pool to contain a surface and
  * initialize the surface.
@@ -88,37 +163,50 @@ static struct Surface *alloc_surface(u32 dynamic) {
 }
 
 /**
- * Add a surface to the correct cell list of surfaces.
- * @param dynamic Determines whether the surface is static or dynamic
- * @param cellX The X position of the cell in which the surface resides
- * @param cellZ The Z position of the cell in which the surface resides
- * @param surface The surface to add
+ * Determine which cell list a surface belongs in, and the direction that list is sorted in.
+ * @param surface The surface to check
+ * @param sortDir Returns the sort direction, which multiplied by upperY gives the surface's priority
  */
-static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surface *surface) {
-    struct SurfaceNode **list;
-    s32 priority;
-    s32 sortDir = 1; // highest to lowest, then insertion order (water and floors)
+static s32 get_surface_list_index(struct Surface *surface, s32 *sortDir) {
     s32 listIndex;
 
+    *sortDir = 1; // highest to lowest, then insertion order (water and floors)
+
     if (SURFACE_IS_NEW_WATER(surface->type)) {
         listIndex = SPATIAL_PARTITION_WATER;
     } else if (surface->normal.y > NORMAL_FLOOR_THRESHOLD) {
         listIndex = SPATIAL_PARTITION_FLOORS;
     } else if (surface->normal.y < NORMAL_CEIL_THRESHOLD) {
         listIndex = SPATIAL_PARTITION_CEILS;
-        sortDir = -1; // lowest to highest, then insertion order
+        *sortDir = -1; // lowest to highest, then insertion order
     } else {
         listIndex = SPATIAL_PARTITION_WALLS;
-        sortDir = 0; // insertion order
+        *sortDir = 0; // insertion order
     }
 
+    return listIndex;
+}
+
+/**
+ * Add a surface to the correct cell list of surfaces.
+ * @param dynamic Determines whether the surface is static or dynamic
+ * @param cellX The X position of the cell in which the surface resides
+ * @param cellZ The Z position of the cell in which the surface resides
+ * @param surface The surface to add
+ */
+static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surface *surface) {
+    struct SurfaceNode **list;
+    s32 priority;
+    s32 sortDir;
+    s32 listIndex = get_surface_list_index(surface, &sortDir);
+
     s32 surfacePriority = surface->upperY * sortDir;
 
     struct SurfaceNode *newNode = alloc_surface_node(dynamic);
-    newNode->surface = surface;
+    set_surface_node(newNode, surface);
 
     if (dynamic) {
-        list = &gDynamicSurfacePartition[cellZ][cellX][listIndex];
+        list = &DYNAMIC_PARTITION_CELL(cellZ, cellX)[listIndex];
         if (sNumCellsUsed >= sizeof(sCellsUsed) / sizeof(struct CellCoords)) {
             sClearAllCells = TRUE;
         } else {
@@ -130,7 +218,7 @@ static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surfac
             }
         }
     } else {
-        list = &gStaticSurfacePartition[cellZ][cellX][listIndex];
+        list = &STATIC_PARTITION_CELL(cellZ, cellX)[listIndex];
     }
 
     if (*list == NULL) {
@@ -201,6 +289,22 @@ static s32 upper_cell_index(s32 coord) {
     return MIN((NUM_CELLS - 1), index);
 }
 
+/**
+ * Finds the range of cells a surface overlaps laterally.
+ * @param surface The surface to check
+ */
+static void get_surface_cell_range(struct Surface *surface, s32 *minCellX, s32 *maxCellX, s32 *minCellZ, s32 *maxCellZ) {
+    s32 minX, maxX, minZ, maxZ;
+
+    min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &minX, &maxX);
+    min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &minZ, &maxZ);
+
+    *minCellX = lower_cell_index(minX);
+    *maxCellX = upper_cell_index(maxX);
+    *minCellZ = lower_cell_index(minZ);
+    *maxCellZ = upper_cell_index(maxZ);
+}
+
 /**
  * Every level is split into 16x16 cells, this takes a surface, finds
  * the appropriate cells (with a buffer), and adds the surface to those
@@ -210,23 +314,41 @@ static s32 upper_cell_index(s32 coord) {
  */
 static void add_surface(struct Surface *surface, s32 dynamic) {
     s32 cellZ, cellX;
-    s32 minX, maxX, minZ, maxZ;
-
-    min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &minX, &maxX);
-    min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &minZ, &maxZ);
+    s32 minCellX, maxCellX, minCellZ, maxCellZ;
 
-    s32 minCellX = lower_cell_index(minX);
-    s32 maxCellX = upper_cell_index(maxX);
-    s32 minCellZ = lower_cell_index(minZ);
-    s32 maxCellZ = upper_cell_index(maxZ);
+    get_surface_cell_range(surface, &minCellX, &maxCellX, &minCellZ, &maxCellZ);
 
     for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
         for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+            if (PARTITION_CELL_IS_REPEAT(cellZ, cellX, minCellZ, minCellX)) continue;
             add_surface_to_cell(dynamic, cellX, cellZ, surface);
         }
     }
 }
 
+#ifdef SURFACE_EDGE_FUNCTIONS
+/**
+ * Precompute the lateral edge equations of a surface, so that for each edge,
+ * edgeX * x + edgeZ * z + edgeOffset gives the same value as the cross product the triangle bounds checks use.
+ * The offset is calculated unsigned so it wraps the same way the original expression would.
+ */
+static void set_surface_edge_functions(struct Surface *surface, Vec3t v[3]) {
+    s32 i, j;
+
+    for (i = 0; i < 3; i++) {
+        j = ((i == 2) ? 0 : (i + 1));
+        s32 dx = (v[j][0] - v[i][0]);
+        s32 dz = (v[j][2] - v[i][2]);
+        surface->edgeX[i] = dz;
+        surface->edgeZ[i] = -dx;
+        surface->edgeOffset[i] = (s32)(((u32)v[i][2] * (u32)dx) - ((u32)v[i][0] * (u32)dz));
+    }
+
+    // Walls never have their height checked, so avoid dividing by zero for them.
+    surface->invNormalY = ((surface->normal.y != 0.0f) ? (1.0f / surface->normal.y) : 0.0f);
+}
+#endif
+
 /**
  * Initializes a Surface struct using the given vertex data
  * @param vertexData The raw data containing vertex positions
@@ -274,6 +396,10 @@ static struct Surface *read_surface_data(TerrainData *vertexData, TerrainData **
     surface->lowerY = (min - SURFACE_VERTICAL_BUFFER);
     surface->upperY = (max + SURFACE_VERTICAL_BUFFER);
 
+#ifdef SURFACE_EDGE_FUNCTIONS
+    set_surface_edge_functions(surface, v);
+#endif
+
     return surface;
 }
 
@@ -361,7 +487,10 @@ static void load_static_surfaces(TerrainData **data, TerrainData *vertexData, s3
             }
 #endif
 
+#ifndef BAKED_STATIC_PARTITION
+            // When baking, surfaces are added to the partition all at once after the area has loaded.
             add_surface(surface, FALSE);
+#endif
         }
 
 #ifdef ALL_SURFACES_HAVE_FORCE
@@ -408,6 +537,9 @@ static void load_environmental_regions(TerrainData **data) {
 void alloc_surface_pools(void) {
     gDynamicSurfacePool = main_pool_alloc(DYNAMIC_SURFACE_POOL_SIZE, MEMORY_POOL_LEFT);
     gDynamicSurfacePoolEnd = gDynamicSurfacePool;
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    reset_dynamic_surface_blocks();
+#endif
 
     gCCMEnteredSlide = FALSE;
     reset_red_coins_collected();
@@ -470,6 +602,215 @@ u32 get_area_terrain_size(TerrainData *data) {
 #endif
 
 
+#ifdef BAKED_STATIC_PARTITION
+struct SurfaceSortEntry {
+    struct Surface *surface;
+    s32 priority;
+    s32 listIndex;
+};
+
+/**
+ * Stable bottom-up merge sort of surfaces from highest to lowest priority.
+ * Equal priorities keep their insertion order, matching add_surface_to_cell.
+ * Returns whichever of the two buffers ended up holding the sorted entries.
+ */
+static struct SurfaceSortEntry *sort_surface_entries(struct SurfaceSortEntry *src, struct SurfaceSortEntry *tmp, s32 count) {
+    struct SurfaceSortEntry *swap;
+
+    for (s32 width = 1; width < count; width *= 2) {
+        for (s32 lo = 0; lo < count; lo += (2 * width)) {
+            s32 mid = MIN(lo + width, count);
+            s32 hi  = MIN(lo + (2 * width), count);
+            s32 i = lo;
+            s32 j = mid;
+            s32 k = lo;
+
+            while (i < mid && j < hi) {
+                tmp[k++] = (src[i].priority >= src[j].priority) ? src[i++] : src[j++];
+            }
+            while (i < mid) tmp[k++] = src[i++];
+            while (j < hi)  tmp[k++] = src[j++];
+        }
+
+        swap = src;
+        src = tmp;
+        tmp = swap;
+    }
+
+    return src;
+}
+
+#ifdef SPARSE_SURFACE_PARTITION
+/**
+ * Divide every coarse cell with at least SPARSE_PARTITION_THRESHOLD surfaces into its cells, in both partitions.
+ * The cells are allocated from the end of the static pool, so they last as long as the area's surfaces do.
+ */
+static void subdivide_dense_partition_cells(struct Surface *surfaces, s32 numSurfaces) {
+    s32 counts[NUM_COARSE_CELLS][NUM_COARSE_CELLS];
+    s32 minCellX, maxCellX, minCellZ, maxCellZ;
+    s32 coarseX, coarseZ;
+    s32 i;
+
+    bzero(counts, sizeof(counts));
+
+    for (i = 0; i < numSurfaces; i++) {
+        get_surface_cell_range(&surfaces[i], &minCellX, &maxCellX, &minCellZ, &maxCellZ);
+
+        for (coarseZ = (minCellZ >> PARTITION_SUBCELL_SHIFT); coarseZ <= (maxCellZ >> PARTITION_SUBCELL_SHIFT); coarseZ++) {
+            for (coarseX = (minCellX >> PARTITION_SUBCELL_SHIFT); coarseX <= (maxCellX >> PARTITION_SUBCELL_SHIFT); coarseX++) {
+                counts[coarseZ][coarseX]++;
+            }
+        }
+    }
+
+    SpatialPartitionCell *subcells = gCurrStaticSurfacePoolEnd;
+
+    for (coarseZ = 0; coarseZ < NUM_COARSE_CELLS; coarseZ++) {
+        for (coarseX = 0; coarseX < NUM_COARSE_CELLS; coarseX++) {
+            if (counts[coarseZ][coarseX] >= SPARSE_PARTITION_THRESHOLD) {
+                gStaticSurfacePartition[coarseZ][coarseX].subcells = subcells;
+                subcells += (PARTITION_SUBCELLS * PARTITION_SUBCELLS);
+                gDynamicSurfacePartition[coarseZ][coarseX].subcells = subcells;
+                subcells += (PARTITION_SUBCELLS * PARTITION_SUBCELLS);
+            }
+        }
+    }
+
+    bzero(gCurrStaticSurfacePoolEnd, ((uintptr_t) subcells - (uintptr_t) gCurrStaticSurfacePoolEnd));
+    gCurrStaticSurfacePoolEnd = subcells;
+}
+#endif
+
+/**
+ * Returns the lists of the static partition in runs of consecutive lists, always in the same order.
+ * Returns NULL once there are no runs left.
+ */
+static struct SurfaceNode **get_static_partition_run(s32 run, s32 *numLists) {
+#ifdef SPARSE_SURFACE_PARTITION
+    if (run >= (NUM_COARSE_CELLS * NUM_COARSE_CELLS)) {
+        return NULL;
+    }
+
+    struct SparsePartitionCell *coarse = &gStaticSurfacePartition[0][0] + run;
+
+    if (coarse->subcells == NULL) {
+        *numLists = NUM_SPATIAL_PARTITIONS;
+        return coarse->lists;
+    }
+
+    *numLists = (PARTITION_SUBCELLS * PARTITION_SUBCELLS * NUM_SPATIAL_PARTITIONS);
+    return coarse->subcells[0];
+#else
+    if (run > 0) {
+        return NULL;
+    }
+
+    *numLists = (NUM_CELLS * NUM_CELLS * NUM_SPATIAL_PARTITIONS);
+    return &gStaticSurfacePartition[0][0][0];
+#endif
+}
+
+/**
+ * Build the static partition from every surface loaded into the current static pool.
+ * Each cell list is written out as one contiguous run of surface nodes, so walking
+ * a list's next pointers walks linear memory. The nodes are allocated from the end of
+ * the static pool, with the sort buffers placed after them and discarded once done.
+ */
+static void bake_static_surface_partition(void) {
+    struct SurfaceNode **lists;
+    struct Surface *surfaces = gCurrStaticSurfacePool;
+    s32 numSurfaces = ((struct Surface *) gCurrStaticSurfacePoolEnd - surfaces);
+    s32 minCellX, maxCellX, minCellZ, maxCellZ;
+    s32 cellX, cellZ;
+    s32 i, run, numLists;
+    u32 numNodes = 0;
+
+    if (numSurfaces == 0) {
+        return;
+    }
+
+#ifdef SPARSE_SURFACE_PARTITION
+    subdivide_dense_partition_cells(surfaces, numSurfaces);
+#endif
+
+    // Count how many nodes each list needs. The list heads hold the counts until the nodes are placed.
+    for (i = 0; i < numSurfaces; i++) {
+        s32 sortDir;
+        s32 listIndex = get_surface_list_index(&surfaces[i], &sortDir);
+
+        get_surface_cell_range(&surfaces[i], &minCellX, &maxCellX, &minCellZ, &maxCellZ);
+
+        for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                if (PARTITION_CELL_IS_REPEAT(cellZ, cellX, minCellZ, minCellX)) continue;
+                ((uintptr_t *) STATIC_PARTITION_CELL(cellZ, cellX))[listIndex]++;
+                numNodes++;
+            }
+        }
+    }
+
+    struct SurfaceNode *nodes = gCurrStaticSurfacePoolEnd;
+    struct SurfaceSortEntry *entries = (struct SurfaceSortEntry *) &nodes[numNodes];
+    struct SurfaceSortEntry *sortBuffer = &entries[numSurfaces];
+
+    for (i = 0; i < numSurfaces; i++) {
+        s32 sortDir;
+        entries[i].surface = &surfaces[i];
+        entries[i].listIndex = get_surface_list_index(&surfaces[i], &sortDir);
+        entries[i].priority = surfaces[i].upperY * sortDir;
+    }
+
+    entries = sort_surface_entries(entries, sortBuffer, numSurfaces);
+
+    // Turn the counts into write cursors, each pointing to the start of its list's run of nodes.
+    struct SurfaceNode *cursor = nodes;
+    for (run = 0; (lists = get_static_partition_run(run, &numLists)) != NULL; run++) {
+        for (i = 0; i < numLists; i++) {
+            uintptr_t count = (uintptr_t) lists[i];
+            lists[i] = cursor;
+            cursor += count;
+        }
+    }
+
+    // Fill in the nodes in sorted order, which leaves each cursor at the end of its list.
+    for (i = 0; i < numSurfaces; i++) {
+        struct Surface *surface = entries[i].surface;
+        s32 listIndex = entries[i].listIndex;
+
+        get_surface_cell_range(surface, &minCellX, &maxCellX, &minCellZ, &maxCellZ);
+
+        for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                if (PARTITION_CELL_IS_REPEAT(cellZ, cellX, minCellZ, minCellX)) continue;
+                struct SurfaceNode *node = STATIC_PARTITION_CELL(cellZ, cellX)[listIndex]++;
+                set_surface_node(node, surface);
+                node->next = (node + 1);
+            }
+        }
+    }
+
+    // Each list ends where the next one starts, so walk them in order to terminate them and restore their heads.
+    cursor = nodes;
+    for (run = 0; (lists = get_static_partition_run(run, &numLists)) != NULL; run++) {
+        for (i = 0; i < numLists; i++) {
+            struct SurfaceNode *listEnd = lists[i];
+
+            if (listEnd == cursor) {
+                lists[i] = NULL;
+            } else {
+                lists[i] = cursor;
+                (listEnd - 1)->next = NULL;
+                cursor = listEnd;
+            }
+        }
+    }
+
+    gCurrStaticSurfacePoolEnd = &nodes[numNodes];
+    gSurfaceNodesAllocated += numNodes;
+}
+#endif
+
+
 /**
  * Process the level file, loading in vertices, surfaces, some objects, and environmental
  * boxes (water, gas, JRB fog).
@@ -487,9 +828,16 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
     bzero(&sCellsUsed, sizeof(sCellsUsed));
     sNumCellsUsed = 0;
     sClearAllCells = TRUE;
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    reset_dynamic_surface_blocks();
+#endif
 
     // Clear the static (level) surface partitions for new use.
     bzero(gStaticSurfacePartition, sizeof(gStaticSurfacePartition));
+#ifdef SPARSE_SURFACE_PARTITION
+    // The subdivided cells of the dynamic partition belonged to the previous area's pool, so start it over undivided.
+    bzero(gDynamicSurfacePartition, sizeof(gDynamicSurfacePartition));
+#endif
     gTotalStaticSurfaceData = 0;
 
     // Initialise a new surface pool for this block of static surface data
@@ -532,15 +880,120 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
         }
     }
 
+#ifdef BAKED_STATIC_PARTITION
+    bake_static_surface_partition();
+#endif
+
     surfacePoolData = (uintptr_t)gCurrStaticSurfacePoolEnd - (uintptr_t)gCurrStaticSurfacePool;
     gTotalStaticSurfaceData += surfacePoolData;
     main_pool_realloc(gCurrStaticSurfacePool, surfacePoolData);
 
     gNumStaticSurfaceNodes = gSurfaceNodesAllocated;
     gNumStaticSurfaces = gSurfacesAllocated;
+    invalidate_collision_query_cache();
     profiler_collision_update(first);
 }
 
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * Unlink every surface node belonging to a block from the dynamic partition.
+ */
+static void remove_dynamic_surface_block(struct DynamicSurfaceBlock *block) {
+    uintptr_t start = (uintptr_t) (block + 1);
+    uintptr_t end = (start + block->used);
+    struct SurfaceNode **list;
+    s32 cellX, cellZ, listIndex;
+
+    for (cellZ = block->minCellZ; cellZ <= block->maxCellZ; cellZ++) {
+        for (cellX = block->minCellX; cellX <= block->maxCellX; cellX++) {
+            if (PARTITION_CELL_IS_REPEAT(cellZ, cellX, block->minCellZ, block->minCellX)) continue;
+
+            for (listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+                list = &DYNAMIC_PARTITION_CELL(cellZ, cellX)[listIndex];
+
+                while (*list != NULL) {
+                    if ((uintptr_t) *list >= start && (uintptr_t) *list < end) {
+                        *list = (*list)->next;
+                    } else {
+                        list = &(*list)->next;
+                    }
+                }
+            }
+        }
+    }
+
+    gSurfacesAllocated -= block->numSurfaces;
+    gSurfaceNodesAllocated -= block->numNodes;
+    block->used = 0;
+    block->numSurfaces = 0;
+    block->numNodes = 0;
+}
+
+/**
+ * Remove the surfaces of an object's block, and leave the block behind as unused.
+ */
+static void free_dynamic_surface_block(s32 index) {
+    struct DynamicSurfaceBlock *block = sDynamicSurfaceBlocks[index];
+
+    remove_dynamic_surface_block(block);
+    invalidate_collision_query_cache();
+    sDynamicSurfacePoolWaste += (sizeof(struct DynamicSurfaceBlock) + block->capacity);
+    sDynamicSurfaceBlocks[index] = NULL;
+}
+
+/**
+ * Remove the surfaces of every object that hasn't loaded its collision this frame.
+ * If terrainObjectsOnly is set, only spawner and surface objects are checked, since the rest haven't been updated yet.
+ */
+void clear_unloaded_dynamic_surfaces(s32 terrainObjectsOnly) {
+    if (gTimeStopState & TIME_STOP_ACTIVE) {
+        return;
+    }
+
+    for (s32 i = 0; i < gObjectPoolCapacity; i++) {
+        struct DynamicSurfaceBlock *block = sDynamicSurfaceBlocks[i];
+
+        if (block == NULL || block->loaded) {
+            continue;
+        }
+
+        if (!terrainObjectsOnly || gObjectPool[i].objList == OBJ_LIST_SPAWNER || gObjectPool[i].objList == OBJ_LIST_SURFACE) {
+            free_dynamic_surface_block(i);
+        }
+    }
+}
+
+/**
+ * Remove the surfaces of an object that is being unloaded, so a new object in its slot doesn't inherit them.
+ */
+void clear_object_dynamic_surfaces(struct Object *obj) {
+    s32 index = (obj - gObjectPool);
+
+    if (index >= 0 && index < gObjectPoolCapacity && sDynamicSurfaceBlocks[index] != NULL) {
+        free_dynamic_surface_block(index);
+    }
+}
+#endif
+
+/**
+ * Empty every list of the dynamic partition.
+ */
+static void clear_dynamic_surface_partition(void) {
+#ifdef SPARSE_SURFACE_PARTITION
+    // Keep the subdivisions, which last as long as the area does.
+    for (s32 i = 0; i < (NUM_COARSE_CELLS * NUM_COARSE_CELLS); i++) {
+        struct SparsePartitionCell *coarse = &gDynamicSurfacePartition[0][0] + i;
+
+        bzero(coarse->lists, sizeof(coarse->lists));
+        if (coarse->subcells != NULL) {
+            bzero(coarse->subcells, (sizeof(SpatialPartitionCell) * PARTITION_SUBCELLS * PARTITION_SUBCELLS));
+        }
+    }
+#else
+    bzero(gDynamicSurfacePartition, sizeof(gDynamicSurfacePartition));
+#endif
+}
+
 /**
  * If not in time stop, clear the surface partitions.
  */
@@ -548,15 +1001,33 @@ void clear_dynamic_surfaces(void) {
     PUPPYPRINT_GET_SNAPSHOT();
     if (!(gTimeStopState & TIME_STOP_ACTIVE)) {
         clear_dynamic_surface_references();
+        invalidate_collision_query_cache();
+
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+        // Blocks are never moved, so once enough of the pool is unused, rebuild it from scratch.
+        if (!sResetDynamicSurfaces && sDynamicSurfacePoolWaste <= (DYNAMIC_SURFACE_POOL_SIZE / 4)) {
+            // Every block left was loaded last frame, as the rest were cleared at the end of it.
+            for (s32 i = 0; i < gObjectPoolCapacity; i++) {
+                if (sDynamicSurfaceBlocks[i] != NULL) {
+                    sDynamicSurfaceBlocks[i]->loaded = FALSE;
+                }
+            }
+            profiler_collision_update(first);
+            return;
+        }
+
+        reset_dynamic_surface_blocks();
+        sResetDynamicSurfaces = FALSE;
+#endif
 
         gSurfacesAllocated = gNumStaticSurfaces;
         gSurfaceNodesAllocated = gNumStaticSurfaceNodes;
         gDynamicSurfacePoolEnd = gDynamicSurfacePool;
         if (sClearAllCells) {
-            bzero(gDynamicSurfacePartition, sizeof(gDynamicSurfacePartition));
+            clear_dynamic_surface_partition();
         } else {
             for (u32 i = 0; i < sNumCellsUsed; i++) {
-                gDynamicSurfacePartition[sCellsUsed[i].z][sCellsUsed[i].x][sCellsUsed[i].partition] = NULL;
+                DYNAMIC_PARTITION_CELL(sCellsUsed[i].z, sCellsUsed[i].x)[sCellsUsed[i].partition] = NULL;
             }
         }
         sNumCellsUsed = 0;
@@ -566,22 +1037,26 @@ void clear_dynamic_surfaces(void) {
 }
 
 /**
- * Applies an object's transformation to the object's vertices.
+ * Builds the transform applied to an object's collision, including its scale.
  */
-void transform_object_vertices(TerrainData **data, TerrainData *vertexData) {
+static void get_object_collision_transform(Mat4 dest) {
     Mat4 *objectTransform = &o->transform;
 
-    register s32 numVertices = *(*data)++;
-
-    register TerrainData *vertices = *data;
-
     if (o->header.gfx.throwMatrix == NULL) {
         o->header.gfx.throwMatrix = objectTransform;
         obj_build_transform_from_pos_and_angle(o, O_POS_INDEX, O_FACE_ANGLE_INDEX);
     }
 
-    Mat4 transform;
-    mtxf_scale_vec3f(transform, *objectTransform, o->header.gfx.scale);
+    mtxf_scale_vec3f(dest, *objectTransform, o->header.gfx.scale);
+}
+
+/**
+ * Applies an object's transformation to the object's vertices.
+ */
+void transform_object_vertices(TerrainData **data, TerrainData *vertexData, Mat4 transform) {
+    register s32 numVertices = *(*data)++;
+
+    register TerrainData *vertices = *data;
 
     // Go through all vertices, rotating and translating them to transform the object.
     Vec3f pos;
@@ -672,6 +1147,144 @@ static void get_optimal_coll_dist(struct Object *obj) {
 
 static TerrainData sVertexData[600];
 
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * Count the surfaces and surface nodes an object's transformed collision will need,
+ * and the range of cells it will be added to.
+ * Returns the number of bytes of the dynamic surface pool needed to load it.
+ */
+static u32 get_object_surface_data_size(TerrainData *collisionData, TerrainData *vertexData, struct DynamicSurfaceBlock *block) {
+    s32 minCellX = (NUM_CELLS - 1), maxCellX = 0;
+    s32 minCellZ = (NUM_CELLS - 1), maxCellZ = 0;
+    s32 minX, maxX, minZ, maxZ;
+    u32 numSurfaces = 0;
+    u32 numNodes = 0;
+
+    // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
+    while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+        s32 surfaceType = *collisionData++;
+        s32 numTris = *collisionData++;
+#ifdef ALL_SURFACES_HAVE_FORCE
+        s32 triSize = 4;
+#else
+        s32 triSize = (3 + surface_has_force(surfaceType));
+#endif
+        (void) surfaceType;
+
+        for (s32 i = 0; i < numTris; i++) {
+            TerrainData *v1 = &vertexData[collisionData[0] * 3];
+            TerrainData *v2 = &vertexData[collisionData[1] * 3];
+            TerrainData *v3 = &vertexData[collisionData[2] * 3];
+
+            min_max_3i(v1[0], v2[0], v3[0], &minX, &maxX);
+            min_max_3i(v1[2], v2[2], v3[2], &minZ, &maxZ);
+
+            minX = lower_cell_index(minX);
+            maxX = upper_cell_index(maxX);
+            minZ = lower_cell_index(minZ);
+            maxZ = upper_cell_index(maxZ);
+
+            numNodes += ((maxX - minX + 1) * (maxZ - minZ + 1));
+            numSurfaces++;
+
+            minCellX = MIN(minCellX, minX);
+            maxCellX = MAX(maxCellX, maxX);
+            minCellZ = MIN(minCellZ, minZ);
+            maxCellZ = MAX(maxCellZ, maxZ);
+
+            collisionData += triSize;
+        }
+    }
+
+    block->minCellX = minCellX;
+    block->maxCellX = maxCellX;
+    block->minCellZ = minCellZ;
+    block->maxCellZ = maxCellZ;
+
+    return ((numSurfaces * sizeof(struct Surface)) + (numNodes * sizeof(struct SurfaceNode)));
+}
+
+/**
+ * Load the object's collision into its block of the dynamic surface pool, unless
+ * the object's collision is already loaded with the same transform.
+ */
+static void load_object_collision_model_incremental(TerrainData *collisionData) {
+    struct DynamicSurfaceBlock *block = sDynamicSurfaceBlocks[o - gObjectPool];
+    Mat4 transform;
+
+    get_object_collision_transform(transform);
+
+    if (block != NULL) {
+        block->loaded = TRUE;
+
+        if (block->collisionData == o->collisionData
+            && block->behavior == o->behavior
+            && !memcmp(block->transform, transform, sizeof(Mat4))
+        ) {
+            return;
+        }
+
+        remove_dynamic_surface_block(block);
+    }
+
+    invalidate_collision_query_cache();
+    transform_object_vertices(&collisionData, sVertexData, transform);
+
+    struct DynamicSurfaceBlock newBounds;
+    u32 size = get_object_surface_data_size(collisionData, sVertexData, &newBounds);
+
+    // If the collision no longer fits in the object's block, leave the old block behind and allocate a new one.
+    if (block == NULL || block->capacity < size) {
+        if (block != NULL) {
+            sDynamicSurfacePoolWaste += (sizeof(struct DynamicSurfaceBlock) + block->capacity);
+            sDynamicSurfaceBlocks[o - gObjectPool] = NULL;
+        }
+
+        // Without room for a new block, the object has no collision this frame, and the pool is rebuilt from scratch next frame.
+        if (((uintptr_t) gDynamicSurfacePoolEnd + sizeof(struct DynamicSurfaceBlock) + size)
+            > ((uintptr_t) gDynamicSurfacePool + DYNAMIC_SURFACE_POOL_SIZE)) {
+            sResetDynamicSurfaces = TRUE;
+            return;
+        }
+
+        block = gDynamicSurfacePoolEnd;
+        gDynamicSurfacePoolEnd = ((u8 *) (block + 1) + size);
+        block->capacity = size;
+        block->loaded = TRUE;
+        sDynamicSurfaceBlocks[o - gObjectPool] = block;
+
+        // Blocks are never moved, so once more than half the pool is used, rebuild it from scratch next frame.
+        if (sDynamicSurfacePoolWaste != 0 && ((uintptr_t) gDynamicSurfacePoolEnd - (uintptr_t) gDynamicSurfacePool) > (DYNAMIC_SURFACE_POOL_SIZE / 2)) {
+            sResetDynamicSurfaces = TRUE;
+        }
+    }
+
+    mtxf_copy(block->transform, transform);
+    block->behavior = o->behavior;
+    block->collisionData = o->collisionData;
+    block->minCellX = newBounds.minCellX;
+    block->maxCellX = newBounds.maxCellX;
+    block->minCellZ = newBounds.minCellZ;
+    block->maxCellZ = newBounds.maxCellZ;
+
+    // Allocate the surfaces from the object's block rather than the end of the pool.
+    void *poolEnd = gDynamicSurfacePoolEnd;
+    s32 surfacesAllocated = gSurfacesAllocated;
+    s32 surfaceNodesAllocated = gSurfaceNodesAllocated;
+    gDynamicSurfacePoolEnd = (block + 1);
+
+    // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
+    while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+        load_object_surfaces(&collisionData, sVertexData, TRUE);
+    }
+
+    block->used = ((uintptr_t) gDynamicSurfacePoolEnd - (uintptr_t) (block + 1));
+    block->numSurfaces = (gSurfacesAllocated - surfacesAllocated);
+    block->numNodes = (gSurfaceNodesAllocated - surfaceNodesAllocated);
+    gDynamicSurfacePoolEnd = poolEnd;
+}
+#endif
+
 /**
  * Transform an object's vertices, reload them, and render the object.
  */
@@ -710,12 +1323,19 @@ void load_object_collision_model(void) {
         && !(o->activeFlags & ACTIVE_FLAG_IN_DIFFERENT_ROOM)
     ) {
         collisionData++;
-        transform_object_vertices(&collisionData, sVertexData);
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+        load_object_collision_model_incremental(collisionData);
+#else
+        Mat4 transform;
+        get_object_collision_transform(transform);
+        transform_object_vertices(&collisionData, sVertexData, transform);
 
         // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
         while (*collisionData != TERRAIN_LOAD_CONTINUE) {
             load_object_surfaces(&collisionData, sVertexData, TRUE);
         }
+        invalidate_collision_query_cache();
+#endif
     }
 
     f32 marioDist = o->oDistanceToMario;
@@ -745,7 +1365,9 @@ void load_object_static_model(void) {
     gSurfacesAllocated = gNumStaticSurfaces;
 
     collisionData++;
-    transform_object_vertices(&collisionData, sVertexData);
+    Mat4 transform;
+    get_object_collision_transform(transform);
+    transform_object_vertices(&collisionData, sVertexData, transform);
 
     // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
     while (*collisionData != TERRAIN_LOAD_CONTINUE) {
@@ -758,5 +1380,6 @@ void load_object_static_model(void) {
 
     gNumStaticSurfaceNodes = gSurfaceNodesAllocated;
     gNumStaticSurfaces = gSurfacesAllocated;
+    invalidate_collision_query_cache();
     profiler_collision_update(first);
 }
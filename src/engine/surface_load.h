@@ -13,14 +13,54 @@
 
 /**
  * The size of the dynamic surface pool, in bytes.
+ * Larger surfaces or surface nodes get room for as many surfaces as the vanilla pool, which holds 0x8000 bytes of 0x30 byte surfaces
+ * with an 8 byte node each.
  */
+#if defined(SURFACE_QUERY_RECORDS) || defined(SURFACE_EDGE_FUNCTIONS)
+#define DYNAMIC_SURFACE_POOL_SURFACES (0x8000 / (0x30 + 0x8))
+#define DYNAMIC_SURFACE_POOL_SIZE ((u32) ALIGN16(DYNAMIC_SURFACE_POOL_SURFACES * (sizeof(struct Surface) + sizeof(struct SurfaceNode))))
+#else
 #define DYNAMIC_SURFACE_POOL_SIZE 0x8000
+#endif
+
+#ifdef SURFACE_QUERY_RECORDS
+/**
+ * A copy of the surface fields that collision checks test before anything else.
+ * Kept inside each surface node so that most surfaces can be rejected without reading the full Surface.
+ */
+struct SurfaceQueryRecord {
+    /*0x00*/ s16 lowerY;
+    /*0x02*/ s16 upperY;
+    /*0x04*/ struct Normal normal;
+    /*0x10*/ f32 originOffset;
+    /*0x14*/ TerrainData vertexX[3];
+    /*0x1A*/ TerrainData vertexZ[3];
+#ifdef SURFACE_EDGE_FUNCTIONS
+    /*0x20*/ s32 edgeX[3];
+    /*0x2C*/ s32 edgeZ[3];
+    /*0x38*/ s32 edgeOffset[3];
+    /*0x44*/ f32 invNormalY;
+#endif
+};
+#endif
 
 struct SurfaceNode {
     struct SurfaceNode *next;
     struct Surface *surface;
+#ifdef SURFACE_QUERY_RECORDS
+    struct SurfaceQueryRecord query;
+#endif
 };
 
+// The fields collision checks reject surfaces with, read from the node when available instead of the surface.
+#ifdef SURFACE_QUERY_RECORDS
+typedef struct SurfaceQueryRecord SurfaceQuery;
+#define SURFACE_NODE_QUERY(node) (&(node)->query)
+#else
+typedef struct Surface SurfaceQuery;
+#define SURFACE_NODE_QUERY(node) ((node)->surface)
+#endif
+
 enum SpatialPartitions {
     SPATIAL_PARTITION_FLOORS,
     SPATIAL_PARTITION_CEILS,
@@ -31,8 +71,72 @@ enum SpatialPartitions {
 
 typedef struct SurfaceNode *SpatialPartitionCell[NUM_SPATIAL_PARTITIONS];
 
+#ifdef SPARSE_SURFACE_PARTITION
+/**
+ * The number of cells along each side of a coarse cell, as a power of two.
+ */
+#define PARTITION_SUBCELL_SHIFT 2
+#define PARTITION_SUBCELLS      (1 << PARTITION_SUBCELL_SHIFT)
+#define PARTITION_SUBCELL_MASK  (PARTITION_SUBCELLS - 1)
+#define NUM_COARSE_CELLS        (NUM_CELLS / PARTITION_SUBCELLS)
+
+/**
+ * A coarse cell of the partition. Until it's subdivided, every cell inside it shares its lists.
+ */
+struct SparsePartitionCell {
+    SpatialPartitionCell lists;
+    SpatialPartitionCell *subcells; // PARTITION_SUBCELLS * PARTITION_SUBCELLS cells once subdivided, otherwise NULL.
+};
+
+extern struct SparsePartitionCell gStaticSurfacePartition[NUM_COARSE_CELLS][NUM_COARSE_CELLS];
+extern struct SparsePartitionCell gDynamicSurfacePartition[NUM_COARSE_CELLS][NUM_COARSE_CELLS];
+
+/**
+ * Returns the lists of the cell at the given cell coordinates.
+ */
+ALWAYS_INLINE struct SurfaceNode **get_partition_cell(struct SparsePartitionCell partition[NUM_COARSE_CELLS][NUM_COARSE_CELLS], s32 cellZ, s32 cellX) {
+    struct SparsePartitionCell *coarse = &partition[(u32) cellZ >> PARTITION_SUBCELL_SHIFT][(u32) cellX >> PARTITION_SUBCELL_SHIFT];
+
+    if (coarse->subcells == NULL) {
+        return coarse->lists;
+    }
+
+    return coarse->subcells[((cellZ & PARTITION_SUBCELL_MASK) << PARTITION_SUBCELL_SHIFT) + (cellX & PARTITION_SUBCELL_MASK)];
+}
+
+#define STATIC_PARTITION_CELL(cellZ, cellX)  get_partition_cell(gStaticSurfacePartition,  (cellZ), (cellX))
+#define DYNAMIC_PARTITION_CELL(cellZ, cellX) get_partition_cell(gDynamicSurfacePartition, (cellZ), (cellX))
+
+/**
+ * Whether a loop over the cells from (minCellZ, minCellX) onwards has already visited the lists of this cell,
+ * which happens for every cell of a coarse cell that isn't subdivided after the first one.
+ */
+#define PARTITION_CELL_IS_REPEAT(cellZ, cellX, minCellZ, minCellX)                                             \
+    ((gStaticSurfacePartition[(u32) (cellZ) >> PARTITION_SUBCELL_SHIFT]                                        \
+                             [(u32) (cellX) >> PARTITION_SUBCELL_SHIFT].subcells == NULL)                      \
+     && ((((cellZ) & PARTITION_SUBCELL_MASK) && ((cellZ) != (minCellZ)))                                       \
+      || (((cellX) & PARTITION_SUBCELL_MASK) && ((cellX) != (minCellX)))))
+
+/**
+ * Moves in bounds cell coordinates to the first cell sharing the same lists, so cells can be compared by their lists.
+ */
+#define get_partition_cell_owner(cellZ, cellX) {                                                                       \
+    if (gStaticSurfacePartition[(u32) (cellZ) >> PARTITION_SUBCELL_SHIFT]                                              \
+                               [(u32) (cellX) >> PARTITION_SUBCELL_SHIFT].subcells == NULL) {                          \
+        (cellZ) &= ~PARTITION_SUBCELL_MASK;                                                                            \
+        (cellX) &= ~PARTITION_SUBCELL_MASK;                                                                            \
+    }                                                                                                                  \
+}
+#else
 extern SpatialPartitionCell gStaticSurfacePartition[NUM_CELLS][NUM_CELLS];
 extern SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
+
+#define STATIC_PARTITION_CELL(cellZ, cellX)  (gStaticSurfacePartition[cellZ][cellX])
+#define DYNAMIC_PARTITION_CELL(cellZ, cellX) (gDynamicSurfacePartition[cellZ][cellX])
+#define PARTITION_CELL_IS_REPEAT(cellZ, cellX, minCellZ, minCellX) FALSE
+#define get_partition_cell_owner(cellZ, cellX)
+#endif
+
 extern void *gCurrStaticSurfacePool;
 extern void *gDynamicSurfacePool;
 extern void *gCurrStaticSurfacePoolEnd;
@@ -45,6 +149,10 @@ u32 get_area_terrain_size(TerrainData *data);
 #endif
 void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, MacroObject *macroObjects);
 void clear_dynamic_surfaces(void);
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+void clear_unloaded_dynamic_surfaces(s32 terrainObjectsOnly);
+void clear_object_dynamic_surfaces(struct Object *obj);
+#endif
 void load_object_collision_model(void);
 void load_object_static_model(void);
 
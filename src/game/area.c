@@ -207,6 +207,10 @@ void clear_areas(void) {
         gAreaData[i].echoOverride = 0;
 #ifdef BETTER_REVERB
         gAreaData[i].betterReverbPreset = 0;
+#endif
+#ifdef ROOM_VISIBILITY_CULLING
+        gAreaData[i].roomVisibility = NULL;
+        gAreaData[i].numVisibilityRooms = 0;
 #endif
     }
 }
@@ -77,6 +77,10 @@ struct Area {
 #ifdef BETTER_REVERB
     /*0x3C*/ u8 betterReverbPreset;
 #endif
+#ifdef ROOM_VISIBILITY_CULLING
+    const RoomVisibility *roomVisibility; // The rooms visible from each room (set from level script cmd 0x41)
+    s16 numVisibilityRooms;
+#endif
 };
 
 // All the transition data to be used in screen_transition.c
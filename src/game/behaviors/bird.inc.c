@@ -89,9 +89,10 @@ static void bird_act_fly(void) {
         }
 
         // Approach to match the bird's target yaw and pitch.
-        obj_move_pitch_approach(o->oBirdTargetPitch, 140);
-        cur_obj_rotate_yaw_toward(o->oBirdTargetYaw, 800);
-        obj_roll_to_match_yaw_turn(o->oBirdTargetYaw, 0x3000, 600);
+        // Turn as far as the bird would have over every frame the update covers.
+        obj_move_pitch_approach(o->oBirdTargetPitch, 140 * gCurrentObjectUpdateInterval);
+        cur_obj_rotate_yaw_toward(o->oBirdTargetYaw, 800 * gCurrentObjectUpdateInterval);
+        obj_roll_to_match_yaw_turn(o->oBirdTargetYaw, 0x3000, 600 * gCurrentObjectUpdateInterval);
     }
 
     // The bird has no gravity, so this function only
@@ -100,7 +101,7 @@ static void bird_act_fly(void) {
     // a constant added to its Y position every frame since
     // its Y velocity is reset every frame by
     // obj_compute_vel_from_move_pitch.
-    cur_obj_move_using_fvel_and_gravity();
+    cur_obj_move_using_fvel_and_gravity_for_interval();
 }
 
 /**
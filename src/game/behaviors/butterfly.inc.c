@@ -11,19 +11,20 @@ void butterfly_step(s32 speed) {
     s16 yaw = o->oMoveAngleYaw;
     s16 pitch = o->oMoveAnglePitch;
     s16 yPhase = o->oButterflyYPhase;
+    s32 frames = gCurrentObjectUpdateInterval;
     f32 floorY;
 
     o->oVelX = sins(yaw) * (f32) speed;
     o->oVelY = sins(pitch) * (f32) speed;
     o->oVelZ = coss(yaw) * (f32) speed;
 
-    o->oPosX += o->oVelX;
-    o->oPosZ += o->oVelZ;
+    o->oPosX += o->oVelX * frames;
+    o->oPosZ += o->oVelZ * frames;
 
     if (o->oAction == BUTTERFLY_ACT_FOLLOW_MARIO) {
-        o->oPosY -= o->oVelY + coss((s32)(yPhase * 655.36f)) * 5.0f; // * 20.0f / 4;
+        o->oPosY -= (o->oVelY + coss((s32)(yPhase * 655.36f)) * 5.0f) * frames; // * 20.0f / 4;
     } else {
-        o->oPosY -= o->oVelY;
+        o->oPosY -= o->oVelY * frames;
     }
 
     floorY = find_floor_height(o->oPosX, o->oPosY, o->oPosZ);
@@ -32,22 +33,20 @@ void butterfly_step(s32 speed) {
         o->oPosY = floorY + 2.0f;
     }
 
-    o->oButterflyYPhase++;
-    if (o->oButterflyYPhase > 100) {
-        o->oButterflyYPhase = 0;
-    }
+    // Advance the phase by every frame the update covers, wrapping from 100 back to 0.
+    o->oButterflyYPhase = (o->oButterflyYPhase + frames) % 101;
 }
 
 void butterfly_calculate_angle(void) {
     s32 yPhase = 5 * o->oButterflyYPhase / 4;
     gMarioObject->oPosX += yPhase;
     gMarioObject->oPosZ += yPhase;
-    obj_turn_toward_object(o, gMarioObject, O_MOVE_ANGLE_YAW_INDEX, 0x300);
+    obj_turn_toward_object(o, gMarioObject, O_MOVE_ANGLE_YAW_INDEX, 0x300 * gCurrentObjectUpdateInterval);
     gMarioObject->oPosX -= yPhase;
     gMarioObject->oPosZ -= yPhase;
     yPhase = (5 * o->oButterflyYPhase + 0x100) / 4;
     gMarioObject->oPosY += yPhase;
-    obj_turn_toward_object(o, gMarioObject, O_MOVE_ANGLE_PITCH_INDEX, 0x500);
+    obj_turn_toward_object(o, gMarioObject, O_MOVE_ANGLE_PITCH_INDEX, 0x500 * gCurrentObjectUpdateInterval);
     gMarioObject->oPosY -= yPhase;
 }
 
@@ -77,12 +76,13 @@ void butterfly_act_return_home(void) {
     f32 homeDistZSq  = sqr(homeDist[2]);
     s16 hAngleToHome = atan2s(homeDist[2], homeDist[0]);
     s16 vAngleToHome = atan2s(sqrtf(homeDistXSq + homeDistZSq), -homeDist[1]);
-    o->oMoveAngleYaw = approach_s16_symmetric(o->oMoveAngleYaw, hAngleToHome, 0x800);
-    o->oMoveAnglePitch = approach_s16_symmetric(o->oMoveAnglePitch, vAngleToHome, 0x50);
+    o->oMoveAngleYaw = approach_s16_symmetric(o->oMoveAngleYaw, hAngleToHome, 0x800 * gCurrentObjectUpdateInterval);
+    o->oMoveAnglePitch = approach_s16_symmetric(o->oMoveAnglePitch, vAngleToHome, 0x50 * gCurrentObjectUpdateInterval);
 
     butterfly_step(7);
 
-    if ((homeDistXSq + sqr(homeDist[1]) + homeDistZSq) < 144.0f) {
+    // Larger steps at a reduced update rate need a larger radius to land in.
+    if ((homeDistXSq + sqr(homeDist[1]) + homeDistZSq) < sqr(12.0f * gCurrentObjectUpdateInterval)) {
         cur_obj_init_animation(BUTTERFLY_ANIM_RESTING);
 
         o->oAction = BUTTERFLY_ACT_RESTING;
@@ -74,12 +74,13 @@ void bhv_fish_spawner_loop(void) {
  */
 static void fish_vertical_roam(s32 speed) {
     f32 parentY = o->parentObj->oPosY;
+    speed *= gCurrentObjectUpdateInterval;
 #ifdef ENABLE_VANILLA_LEVEL_SPECIFIC_CHECKS //! TODO: Make this a param
     // If the stage is Secret Aquarium, the fish can
     // travel as far vertically as they wish.
     if (gCurrLevelNum == LEVEL_SA) {
         if (500.0f < absf(o->oPosY - o->oFishGoalY)) {
-            speed = 10;
+            speed = 10 * gCurrentObjectUpdateInterval;
         }
         o->oPosY = approach_f32_symmetric(o->oPosY, o->oFishGoalY, speed);
 
@@ -119,7 +120,7 @@ static void fish_act_roam(void) {
     o->oFishGoalY = gMarioObject->oPosY + o->oFishHeightOffset;
 
     // Rotate the fish towards Mario.
-    cur_obj_rotate_yaw_toward(o->oAngleToMario, 0x400);
+    cur_obj_rotate_yaw_toward(o->oAngleToMario, 0x400 * gCurrentObjectUpdateInterval);
 
     if (o->oPosY < o->oFishWaterLevel - 50.0f) {
         if (absf(fishY) < 500.0f) {
@@ -168,12 +169,12 @@ static void fish_act_flee(void) {
 
     // Accelerate over time.
     if (o->oForwardVel < o->oFishGoalVel) {
-        o->oForwardVel += 0.5f;
+        o->oForwardVel += 0.5f * gCurrentObjectUpdateInterval;
     }
     o->oFishGoalY = gMarioObject->oPosY + o->oFishHeightOffset;
 
     // Rotate fish away from Mario.
-    cur_obj_rotate_yaw_toward(o->oAngleToMario + 0x8000, o->oFishYawVel);
+    cur_obj_rotate_yaw_toward(o->oAngleToMario + 0x8000, o->oFishYawVel * gCurrentObjectUpdateInterval);
 
     if (o->oPosY < o->oFishWaterLevel - 50.0f) {
         if (absf(fishY) < 500.0f) {
@@ -247,7 +248,7 @@ void bhv_fish_loop(void) {
 
     // Call fish action methods and apply physics engine.
     cur_obj_call_action_function(sFishActions);
-    cur_obj_move_using_fvel_and_gravity();
+    cur_obj_move_using_fvel_and_gravity_for_interval();
 
     // If the parent object has action set to two, then delete the fish object.
     if (o->parentObj->oAction == FISH_SPAWNER_ACT_RESPAWN) {
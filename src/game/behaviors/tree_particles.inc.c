@@ -14,7 +14,7 @@ void bhv_tree_snow_or_leaf_loop(void) {
         o->oPosY < o->oFloorHeight
         || o->oFloorHeight < FLOOR_LOWER_LIMIT
         || o->oTimer > 100
-        || gPrevFrameObjectCount > OBJECT_POOL_CAPACITY - 28
+        || gPrevFrameObjectCount > gObjectPoolCapacity - 28
     ) {
         obj_mark_for_deletion(o);
     }
@@ -210,14 +210,14 @@ void iterate_surfaces_visual(s32 x, s32 z, Vtx *verts) {
 
     for (i = 0; i < (2 * NUM_SPATIAL_PARTITIONS); i++) {
         switch (i) {
-            case 0: node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_GREEN ); break;
-            case 1: node =  gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_GREEN ); break;
-            case 2: node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_BLUE  ); break;
-            case 3: node =  gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_BLUE  ); break;
-            case 4: node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_RED   ); break;
-            case 5: node =  gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_RED   ); break;
-            case 6: node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_YELLOW); break;
-            case 7: node =  gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_YELLOW); break;
+            case 0: node = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_GREEN ); break;
+            case 1: node =  STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_GREEN ); break;
+            case 2: node = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_BLUE  ); break;
+            case 3: node =  STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_BLUE  ); break;
+            case 4: node = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_RED   ); break;
+            case 5: node =  STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_RED   ); break;
+            case 6: node = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WATER ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_YELLOW); break;
+            case 7: node =  STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WATER ]; colorRGB_copy(col, (ColorRGB)COLOR_RGB_YELLOW); break;
         }
 
         while (node != NULL) {
@@ -318,14 +318,14 @@ s32 iterate_surface_count(s32 x, s32 z) {
 
     for (i = 0; i < (2 * NUM_SPATIAL_PARTITIONS); i++) {
         switch (i) {
-            case 0: node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ]; break;
-            case 1: node =  gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ]; break;
-            case 2: node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS]; break;
-            case 3: node =  gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS]; break;
-            case 4: node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ]; break;
-            case 5: node =  gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ]; break;
-            case 6: node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ]; break;
-            case 7: node =  gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ]; break;
+            case 0: node = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS ]; break;
+            case 1: node =  STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WALLS ]; break;
+            case 2: node = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS]; break;
+            case 3: node =  STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_FLOORS]; break;
+            case 4: node = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS ]; break;
+            case 5: node =  STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_CEILS ]; break;
+            case 6: node = DYNAMIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WATER ]; break;
+            case 7: node =  STATIC_PARTITION_CELL(cellZ, cellX)[SPATIAL_PARTITION_WATER ]; break;
         }
 
         while (node != NULL) {
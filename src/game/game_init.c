@@ -16,6 +16,7 @@
 #include "seq_ids.h"
 #include "sound_init.h"
 #include "print.h"
+#include "rendering_graph_node.h"
 #include "segment2.h"
 #include "segment_symbols.h"
 #include "rumble_init.h"
@@ -741,17 +742,31 @@ void setup_game_memory(void) {
     gPhysicalFramebuffers[1] = VIRTUAL_TO_PHYSICAL(gFramebuffer1);
     gPhysicalFramebuffers[2] = VIRTUAL_TO_PHYSICAL(gFramebuffer2);
     // Setup Mario Animations
-    gMarioAnimsMemAlloc = main_pool_alloc(MARIO_ANIMS_POOL_SIZE, MEMORY_POOL_LEFT);
-    set_segment_base_addr(SEGMENT_MARIO_ANIMS, (void *) gMarioAnimsMemAlloc);
-    setup_dma_table_list(&gMarioAnimsBuf, gMarioAnims, gMarioAnimsMemAlloc);
+    s32 useAnimsBuffer = TRUE;
+    setup_dma_table_list(&gMarioAnimsBuf, gMarioAnims, NULL);
+#ifdef MARIO_ANIM_CACHE
+    // The cache slots hold the animations, so the single buffer is only needed if they didn't fit.
+    useAnimsBuffer = !setup_dma_table_cache(&gMarioAnimsBuf, MARIO_ANIM_CACHE_SLOTS);
+#endif
+    if (useAnimsBuffer) {
+        gMarioAnimsMemAlloc = main_pool_alloc(MARIO_ANIMS_POOL_SIZE, MEMORY_POOL_LEFT);
+        set_segment_base_addr(SEGMENT_MARIO_ANIMS, (void *) gMarioAnimsMemAlloc);
+        gMarioAnimsBuf.bufTarget = gMarioAnimsMemAlloc;
+#ifdef PUPPYPRINT_DEBUG
+        set_segment_memory_printout(SEGMENT_MARIO_ANIMS, MARIO_ANIMS_POOL_SIZE);
+#endif
+    }
 #ifdef PUPPYPRINT_DEBUG
-    set_segment_memory_printout(SEGMENT_MARIO_ANIMS, MARIO_ANIMS_POOL_SIZE);
     set_segment_memory_printout(SEGMENT_DEMO_INPUTS, DEMO_INPUTS_POOL_SIZE);
 #endif
     // Setup Demo Inputs List
     gDemoInputsMemAlloc = main_pool_alloc(DEMO_INPUTS_POOL_SIZE, MEMORY_POOL_LEFT);
     set_segment_base_addr(SEGMENT_DEMO_INPUTS, (void *) gDemoInputsMemAlloc);
     setup_dma_table_list(&gDemoInputsBuf, gDemoInputs, gDemoInputsMemAlloc);
+#ifdef MATRIX_CACHE
+    // Setup the cache of fixed point matrices
+    alloc_matrix_cache();
+#endif
     // Setup Level Script Entry
     load_segment(SEGMENT_LEVEL_ENTRY, _entrySegmentRomStart, _entrySegmentRomEnd, MEMORY_POOL_LEFT, NULL, NULL);
     // Setup Segment 2 (Fonts, Text, etc)
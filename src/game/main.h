@@ -89,6 +89,9 @@ extern struct VblankHandler *gVblankHandler1;
 extern struct VblankHandler *gVblankHandler2;
 extern struct SPTask *gActiveSPTask;
 extern s8 gAudioEnabled;
+#ifdef ADAPTIVE_NOTE_CAP
+extern u32 gAudioRspCycles;
+#endif
 extern u32 gNumVblanks;
 extern s8 gResetTimer;
 extern s8 gNmiResetBarsTimer;
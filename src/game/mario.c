@@ -61,9 +61,11 @@ s32 is_anim_past_end(struct MarioState *m) {
  */
 s16 set_mario_animation(struct MarioState *m, s32 targetAnimID) {
     struct Object *marioObj = m->marioObj;
+    s32 loaded = load_patchable_table(m->animList, targetAnimID);
+    // Read the buffer after loading, since the animation may have been loaded into a different one.
     struct Animation *targetAnim = m->animList->bufTarget;
 
-    if (load_patchable_table(m->animList, targetAnimID)) {
+    if (loaded) {
         targetAnim->values = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->values);
         targetAnim->index  = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->index);
     }
@@ -94,9 +96,11 @@ s16 set_mario_animation(struct MarioState *m, s32 targetAnimID) {
  */
 s16 set_mario_anim_with_accel(struct MarioState *m, s32 targetAnimID, s32 accel) {
     struct Object *marioObj = m->marioObj;
+    s32 loaded = load_patchable_table(m->animList, targetAnimID);
+    // Read the buffer after loading, since the animation may have been loaded into a different one.
     struct Animation *targetAnim = m->animList->bufTarget;
 
-    if (load_patchable_table(m->animList, targetAnimID)) {
+    if (loaded) {
         targetAnim->values = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->values);
         targetAnim->index = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->index);
     }
@@ -27,6 +27,12 @@ struct Surface gWaterSurfacePseudoFloor = {
     { 0.0f, 1.0f, 0.0f },       // normal
     0.0f,                       // originOffset
     NULL,                       // object
+#ifdef SURFACE_EDGE_FUNCTIONS
+    { 0, 0, 0 },                // edgeX
+    { 0, 0, 0 },                // edgeZ
+    { 0, 0, 0 },                // edgeOffset
+    1.0f,                       // invNormalY
+#endif
 };
 
 /**
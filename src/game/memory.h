@@ -32,10 +32,27 @@ struct DmaTable {
     struct OffsetSizePair anim[1]; // dynamic size
 };
 
+#ifdef MARIO_ANIM_CACHE
+struct DmaCacheSlot {
+    u8 *addr; // The ROM address of the data in this slot, or NULL if it's empty.
+    void *buffer;
+    u32 lastUsed;
+    u8 loading; // Whether an asynchronous DMA into this slot hasn't been received yet.
+    u8 fresh;   // Whether the data in this slot was loaded and hasn't been returned by load_patchable_table yet.
+};
+#endif
+
 struct DmaHandlerList {
     struct DmaTable *dmaTable;
     void *currentAddr;
     void *bufTarget;
+#ifdef MARIO_ANIM_CACHE
+    struct DmaCacheSlot *slots; // NULL if the list only has its single buffer.
+    s16 *nextIndex;             // The index that was last loaded after each index, or -1.
+    s32 currentIndex;
+    s32 numSlots;
+    u32 useCounter;
+#endif
 };
 
 #define EFFECTS_MEMORY_POOL 0x4000
@@ -79,5 +96,8 @@ void mem_pool_free(struct MemoryPool *pool, void *addr);
 void *alloc_display_list(u32 size);
 void setup_dma_table_list(struct DmaHandlerList *list, void *srcAddr, void *buffer);
 s32 load_patchable_table(struct DmaHandlerList *list, s32 index);
+#ifdef MARIO_ANIM_CACHE
+s32 setup_dma_table_cache(struct DmaHandlerList *list, s32 numSlots);
+#endif
 
 #endif // MEMORY_H
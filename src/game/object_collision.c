@@ -7,6 +7,41 @@
 #include "object_list_processor.h"
 #include "spawn_object.h"
 #include "engine/math_util.h"
+#include "config/config_world.h"
+
+#ifdef OBJECT_COLLISION_BROADPHASE
+#define OBJ_COLLISION_GRID_CELLS     16
+#define OBJ_COLLISION_GRID_CELL_SIZE (2 * LEVEL_BOUNDARY_MAX / OBJ_COLLISION_GRID_CELLS)
+// Objects whose hitbox spans more cells than this on either axis are kept in a separate list that's always checked.
+#define OBJ_COLLISION_GRID_MAX_SPAN  2
+#define OBJ_COLLISION_GRID_ENTRIES   (OBJECT_POOL_MAX_CAPACITY * 2)
+
+struct ObjectCollisionGridEntry {
+    struct Object *obj;
+    u16 next; // Index of the next entry in the cell plus one, 0 ends the cell.
+};
+
+/**
+ * The first entry (plus one) of each grid cell, for each object list.
+ * Oversized objects go in the extra cell at the end of each list's grid.
+ */
+static u16 sCollisionGridHeads[NUM_OBJ_LISTS][(OBJ_COLLISION_GRID_CELLS * OBJ_COLLISION_GRID_CELLS) + 1];
+static struct ObjectCollisionGridEntry sCollisionGridEntries[OBJ_COLLISION_GRID_ENTRIES];
+static u16 sNumCollisionGridEntries;
+static u16 sNumCollisionGridObjects;
+
+/**
+ * Each object's position within its object list, indexed by its slot in the object pool.
+ */
+static u16 sCollisionListOrder[OBJECT_POOL_MAX_CAPACITY];
+
+/**
+ * Marks which objects were already gathered by the current query, so objects in several cells are only checked once.
+ */
+static u16 sCollisionQueryStamps[OBJECT_POOL_MAX_CAPACITY];
+static u16 sCollisionQueryStamp;
+static struct Object *sCollisionCandidates[OBJECT_POOL_MAX_CAPACITY];
+#endif
 
 UNUSED struct Object *debug_print_obj_collision(struct Object *a) {
     struct Object *currCollidedObj;
@@ -80,8 +115,101 @@ s32 detect_object_hurtbox_overlap(struct Object *a, struct Object *b) {
     return FALSE;
 }
 
+#ifdef OBJECT_COLLISION_BROADPHASE
+static s32 obj_collision_grid_cell(f32 coord) {
+    coord = ((coord + LEVEL_BOUNDARY_MAX) / OBJ_COLLISION_GRID_CELL_SIZE);
+
+    if (!(coord >= 0.0f)) {
+        return 0;
+    }
+    if (coord >= OBJ_COLLISION_GRID_CELLS) {
+        return (OBJ_COLLISION_GRID_CELLS - 1);
+    }
+    return (s32) coord;
+}
+
+/**
+ * Get the range of grid cells an object's hitbox overlaps on the XZ plane.
+ * Returns FALSE if it overlaps too many cells to be worth using the grid for.
+ */
+static s32 get_hitbox_grid_cells(struct Object *obj, s32 *minX, s32 *maxX, s32 *minZ, s32 *maxZ) {
+    f32 radius = obj->hitboxRadius;
+
+    *minX = obj_collision_grid_cell(obj->oPosX - radius);
+    *maxX = obj_collision_grid_cell(obj->oPosX + radius);
+    *minZ = obj_collision_grid_cell(obj->oPosZ - radius);
+    *maxZ = obj_collision_grid_cell(obj->oPosZ + radius);
+
+    return ((*maxX - *minX) < OBJ_COLLISION_GRID_MAX_SPAN && (*maxZ - *minZ) < OBJ_COLLISION_GRID_MAX_SPAN);
+}
+
+static void add_collision_grid_entry(struct Object *obj, u16 *head) {
+    struct ObjectCollisionGridEntry *entry = &sCollisionGridEntries[sNumCollisionGridEntries++];
+
+    entry->obj = obj;
+    entry->next = *head;
+    *head = sNumCollisionGridEntries;
+}
+
+static void add_object_to_collision_grid(struct Object *obj, s32 objList, u16 order) {
+    u16 *heads = sCollisionGridHeads[objList];
+    s32 minX, maxX, minZ, maxZ, x, z;
+
+    sCollisionListOrder[obj - gObjectPool] = order;
+    sNumCollisionGridObjects++;
+
+    // Objects that don't fit in the grid go in the oversized cell instead. Keep an entry spare for
+    // every object that could still be added, so there's always room for them in the oversized cell.
+    if (!get_hitbox_grid_cells(obj, &minX, &maxX, &minZ, &maxZ)
+        || (sNumCollisionGridEntries + ((maxX - minX + 1) * (maxZ - minZ + 1)))
+            > (OBJ_COLLISION_GRID_ENTRIES - (OBJECT_POOL_MAX_CAPACITY - sNumCollisionGridObjects))) {
+        add_collision_grid_entry(obj, &heads[OBJ_COLLISION_GRID_CELLS * OBJ_COLLISION_GRID_CELLS]);
+        return;
+    }
+
+    for (z = minZ; z <= maxZ; z++) {
+        for (x = minX; x <= maxX; x++) {
+            add_collision_grid_entry(obj, &heads[(z * OBJ_COLLISION_GRID_CELLS) + x]);
+        }
+    }
+}
+
+/**
+ * Add the objects in a grid cell that come at or after startOrder in their list to the candidates,
+ * keeping the candidates in list order.
+ */
+static s32 gather_collision_candidates(u16 entryIndex, u16 startOrder, s32 numCandidates) {
+    while (entryIndex != 0) {
+        struct ObjectCollisionGridEntry *entry = &sCollisionGridEntries[entryIndex - 1];
+        struct Object *obj = entry->obj;
+        s32 slot = (obj - gObjectPool);
+        u16 order = sCollisionListOrder[slot];
+
+        if (order >= startOrder && sCollisionQueryStamps[slot] != sCollisionQueryStamp) {
+            s32 i = numCandidates++;
+
+            sCollisionQueryStamps[slot] = sCollisionQueryStamp;
+
+            while (i > 0 && sCollisionListOrder[sCollisionCandidates[i - 1] - gObjectPool] > order) {
+                sCollisionCandidates[i] = sCollisionCandidates[i - 1];
+                i--;
+            }
+            sCollisionCandidates[i] = obj;
+        }
+
+        entryIndex = entry->next;
+    }
+
+    return numCandidates;
+}
+#endif
+
 void clear_object_collision(struct Object *a) {
     struct Object *nextObj = (struct Object *) a->header.next;
+#ifdef OBJECT_COLLISION_BROADPHASE
+    s32 objList = ((struct ObjectNode *) a - gObjectLists);
+    u16 order = 0;
+#endif
 
     while (nextObj != a) {
         nextObj->numCollidedObjs = 0;
@@ -89,6 +217,9 @@ void clear_object_collision(struct Object *a) {
         if (nextObj->oIntangibleTimer > 0) {
             nextObj->oIntangibleTimer--;
         }
+#ifdef OBJECT_COLLISION_BROADPHASE
+        add_object_to_collision_grid(nextObj, objList, order++);
+#endif
         nextObj = (struct Object *) nextObj->header.next;
     }
 }
@@ -106,30 +237,65 @@ void check_collision_in_list(struct Object *a, struct Object *b, struct Object *
     }
 }
 
+/**
+ * Check an object for collisions with every object from b to the end of the given object list.
+ */
+void check_collision_in_obj_list(struct Object *a, struct Object *b, s32 objList) {
+#ifdef OBJECT_COLLISION_BROADPHASE
+    struct Object *listHead = (struct Object *) &gObjectLists[objList];
+    u16 *heads = sCollisionGridHeads[objList];
+    s32 minX, maxX, minZ, maxZ, x, z;
+    s32 numCandidates, i;
+
+    if (a->oIntangibleTimer != 0 || b == listHead) {
+        return;
+    }
+
+    if (!get_hitbox_grid_cells(a, &minX, &maxX, &minZ, &maxZ)) {
+        check_collision_in_list(a, b, listHead);
+        return;
+    }
+
+    if (++sCollisionQueryStamp == 0) {
+        bzero(sCollisionQueryStamps, sizeof(sCollisionQueryStamps));
+        sCollisionQueryStamp = 1;
+    }
+
+    // Any object whose hitbox overlaps a's on the XZ plane shares at least one cell with it.
+    u16 startOrder = sCollisionListOrder[b - gObjectPool];
+    numCandidates = gather_collision_candidates(heads[OBJ_COLLISION_GRID_CELLS * OBJ_COLLISION_GRID_CELLS], startOrder, 0);
+    for (z = minZ; z <= maxZ; z++) {
+        for (x = minX; x <= maxX; x++) {
+            numCandidates = gather_collision_candidates(heads[(z * OBJ_COLLISION_GRID_CELLS) + x], startOrder, numCandidates);
+        }
+    }
+
+    for (i = 0; i < numCandidates; i++) {
+        b = sCollisionCandidates[i];
+
+        if (b->oIntangibleTimer == 0) {
+            if (detect_object_hitbox_overlap(a, b) && b->hurtboxRadius != 0.0f) {
+                detect_object_hurtbox_overlap(a, b);
+            }
+        }
+    }
+#else
+    check_collision_in_list(a, b, (struct Object *) &gObjectLists[objList]);
+#endif
+}
+
 void check_player_object_collision(void) {
     struct Object *playerObj = (struct Object *) &gObjectLists[OBJ_LIST_PLAYER];
     struct Object   *nextObj = (struct Object *) playerObj->header.next;
 
     while (nextObj != playerObj) {
-        check_collision_in_list(nextObj, (struct Object *) nextObj->header.next, playerObj);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_POLELIKE].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_POLELIKE]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_LEVEL].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_LEVEL]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_GENACTOR].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_GENACTOR]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_PUSHABLE].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_SURFACE].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_SURFACE]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_DESTRUCTIVE].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_DESTRUCTIVE]);
+        check_collision_in_obj_list(nextObj, (struct Object *) nextObj->header.next, OBJ_LIST_PLAYER);
+        check_collision_in_obj_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_POLELIKE].next, OBJ_LIST_POLELIKE);
+        check_collision_in_obj_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_LEVEL].next, OBJ_LIST_LEVEL);
+        check_collision_in_obj_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_GENACTOR].next, OBJ_LIST_GENACTOR);
+        check_collision_in_obj_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_PUSHABLE].next, OBJ_LIST_PUSHABLE);
+        check_collision_in_obj_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_SURFACE].next, OBJ_LIST_SURFACE);
+        check_collision_in_obj_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_DESTRUCTIVE].next, OBJ_LIST_DESTRUCTIVE);
         nextObj = (struct Object *) nextObj->header.next;
     }
 }
@@ -139,7 +305,7 @@ void check_pushable_object_collision(void) {
     struct Object *nextObj = (struct Object *) pushableObj->header.next;
 
     while (nextObj != pushableObj) {
-        check_collision_in_list(nextObj, (struct Object *) nextObj->header.next, pushableObj);
+        check_collision_in_obj_list(nextObj, (struct Object *) nextObj->header.next, OBJ_LIST_PUSHABLE);
         nextObj = (struct Object *) nextObj->header.next;
     }
 }
@@ -150,19 +316,21 @@ void check_destructive_object_collision(void) {
 
     while (nextObj != destructiveObj) {
         if (nextObj->oDistanceToMario < 2000.0f && !(nextObj->activeFlags & ACTIVE_FLAG_DESTRUCTIVE_OBJ_DONT_DESTROY)) {
-            check_collision_in_list(nextObj, (struct Object *) nextObj->header.next, destructiveObj);
-            check_collision_in_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_GENACTOR].next,
-                          (struct Object *) &gObjectLists[OBJ_LIST_GENACTOR]);
-            check_collision_in_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_PUSHABLE].next,
-                          (struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE]);
-            check_collision_in_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_SURFACE].next,
-                          (struct Object *) &gObjectLists[OBJ_LIST_SURFACE]);
+            check_collision_in_obj_list(nextObj, (struct Object *) nextObj->header.next, OBJ_LIST_DESTRUCTIVE);
+            check_collision_in_obj_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_GENACTOR].next, OBJ_LIST_GENACTOR);
+            check_collision_in_obj_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_PUSHABLE].next, OBJ_LIST_PUSHABLE);
+            check_collision_in_obj_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_SURFACE].next, OBJ_LIST_SURFACE);
         }
         nextObj = (struct Object *) nextObj->header.next;
     }
 }
 
 void detect_object_collisions(void) {
+#ifdef OBJECT_COLLISION_BROADPHASE
+    bzero(sCollisionGridHeads, sizeof(sCollisionGridHeads));
+    sNumCollisionGridEntries = 0;
+    sNumCollisionGridObjects = 0;
+#endif
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_POLELIKE]);
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_PLAYER]);
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE]);
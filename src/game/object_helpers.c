@@ -141,6 +141,63 @@ Gfx *geo_switch_area(s32 callContext, struct GraphNode *node, UNUSED void *conte
     return NULL;
 }
 
+#ifdef ROOM_VISIBILITY_CULLING
+/**
+ * Update Mario's room once a frame, for areas that don't switch their geometry with geo_switch_area.
+ */
+static void update_mario_room(void) {
+    static u32 sMarioRoomUpdateFrame = 0;
+
+    if (gMarioObject != NULL && sMarioRoomUpdateFrame != gGlobalTimer + 1) {
+        RoomData room = get_room_at_pos(gMarioObject->oPosX, gMarioObject->oPosY, gMarioObject->oPosZ);
+
+        sMarioRoomUpdateFrame = gGlobalTimer + 1;
+        if (room > 0) {
+            gMarioCurrentRoom = room;
+        }
+    }
+}
+
+/**
+ * Whether a room may be visible from Mario's room, according to the current area's room visibility.
+ * The global room, unknown rooms and areas without room visibility are always visible.
+ */
+s32 room_is_visible_from_mario_room(s32 room) {
+    const RoomVisibility *visibility = (gCurrentArea != NULL) ? gCurrentArea->roomVisibility : NULL;
+
+    if (visibility == NULL || room <= 0 || gMarioCurrentRoom <= 0
+        || room >= gCurrentArea->numVisibilityRooms || gMarioCurrentRoom >= gCurrentArea->numVisibilityRooms) {
+        return TRUE;
+    }
+
+    return (visibility[gMarioCurrentRoom][room >> 5] >> (room & 31)) & 1;
+}
+
+/**
+ * Shows or hides the nodes after this one in its group, depending on whether the room in the parameter
+ * may be visible from Mario's room. Put GEO_ASM(room, geo_room_visibility) first in a group with the room's geometry.
+ */
+Gfx *geo_room_visibility(s32 callContext, struct GraphNode *node, UNUSED void *context) {
+    struct GraphNodeGenerated *asmNode = (struct GraphNodeGenerated *) node;
+    struct GraphNode *sibling;
+
+    if (callContext == GEO_CONTEXT_RENDER) {
+        update_mario_room();
+        s32 visible = room_is_visible_from_mario_room(asmNode->parameter);
+
+        for (sibling = node->next; sibling != node; sibling = sibling->next) {
+            if (visible) {
+                sibling->flags |= GRAPH_RENDER_ACTIVE;
+            } else {
+                sibling->flags &= ~GRAPH_RENDER_ACTIVE;
+            }
+        }
+    }
+
+    return NULL;
+}
+#endif
+
 void obj_update_pos_from_parent_transformation(Mat4 a0, struct Object *a1) {
     f32 spC = a1->oParentRelativePosX;
     f32 sp8 = a1->oParentRelativePosY;
@@ -598,11 +655,28 @@ f32 cur_obj_dist_to_nearest_object_with_behavior(const BehaviorScript *behavior)
 
 struct Object *cur_obj_find_nearest_object_with_behavior(const BehaviorScript *behavior, f32 *dist) {
     uintptr_t *behaviorAddr = segmented_to_virtual(behavior);
-    struct ObjectNode *listHead = &gObjectLists[get_object_list_from_behavior(behaviorAddr)];
-    struct Object *obj = (struct Object *) listHead->next;
+    struct BehaviorObjectList *bhvList = get_behavior_object_list(behaviorAddr);
     struct Object *closestObj = NULL;
     f32 minDist = 0x20000;
 
+    if (bhvList != NULL) {
+        for (struct Object *obj = bhvList->head; obj != NULL; obj = obj->nextWithBehavior) {
+            if (obj->activeFlags != ACTIVE_FLAG_DEACTIVATED && obj != o) {
+                f32 objDist = dist_between_objects(o, obj);
+                if (objDist < minDist) {
+                    closestObj = obj;
+                    minDist = objDist;
+                }
+            }
+        }
+
+        *dist = minDist;
+        return closestObj;
+    }
+
+    struct ObjectNode *listHead = &gObjectLists[get_object_list_from_behavior(behaviorAddr)];
+    struct Object *obj = (struct Object *) listHead->next;
+
     while (obj != (struct Object *) listHead) {
         if (obj->behavior == behaviorAddr
             && obj->activeFlags != ACTIVE_FLAG_DEACTIVATED
@@ -648,9 +722,19 @@ s32 count_unimportant_objects(void) {
 
 s32 count_objects_with_behavior(const BehaviorScript *behavior) {
     uintptr_t *behaviorAddr = segmented_to_virtual(behavior);
+    struct BehaviorObjectList *bhvList = get_behavior_object_list(behaviorAddr);
+    s32 count = 0;
+
+    if (bhvList != NULL) {
+        for (struct Object *obj = bhvList->head; obj != NULL; obj = obj->nextWithBehavior) {
+            count++;
+        }
+
+        return count;
+    }
+
     struct ObjectNode *listHead = &gObjectLists[get_object_list_from_behavior(behaviorAddr)];
     struct ObjectNode *obj = listHead->next;
-    s32 count = 0;
 
     while (listHead != obj) {
         if (((struct Object *) obj)->behavior == behaviorAddr) {
@@ -665,9 +749,29 @@ s32 count_objects_with_behavior(const BehaviorScript *behavior) {
 
 struct Object *cur_obj_find_nearby_held_actor(const BehaviorScript *behavior, f32 maxDist) {
     const BehaviorScript *behaviorAddr = segmented_to_virtual(behavior);
+    struct Object *foundObj = NULL;
+
+    // Only general actors are searched, so the index can only be used for general actor behaviors.
+    if (get_object_list_from_behavior(behaviorAddr) == OBJ_LIST_GENACTOR) {
+        struct BehaviorObjectList *bhvList = get_behavior_object_list(behaviorAddr);
+
+        if (bhvList != NULL) {
+            for (struct Object *obj = bhvList->head; obj != NULL; obj = obj->nextWithBehavior) {
+                if (obj->activeFlags != ACTIVE_FLAG_DEACTIVATED
+                    && obj->oHeldState != HELD_FREE
+                    && dist_between_objects(o, obj) < maxDist
+                ) {
+                    foundObj = obj;
+                    break;
+                }
+            }
+
+            return foundObj;
+        }
+    }
+
     struct ObjectNode *listHead = &gObjectLists[OBJ_LIST_GENACTOR];
     struct Object *obj = (struct Object *) listHead->next;
-    struct Object *foundObj = NULL;
 
     while ((struct Object *) listHead != obj) {
         if (
@@ -1174,11 +1278,13 @@ s32 obj_check_if_collided_with_object(struct Object *obj1, struct Object *obj2)
 }
 
 void cur_obj_set_behavior(const BehaviorScript *behavior) {
-    o->behavior = segmented_to_virtual(behavior);
+    obj_set_behavior(o, behavior);
 }
 
 void obj_set_behavior(struct Object *obj, const BehaviorScript *behavior) {
+    remove_object_from_behavior_index(obj);
     obj->behavior = segmented_to_virtual(behavior);
+    add_object_to_behavior_index(obj);
 }
 
 s32 cur_obj_has_behavior(const BehaviorScript *behavior) {
@@ -1476,6 +1582,20 @@ void cur_obj_move_using_fvel_and_gravity(void) {
     cur_obj_move_using_vel_and_gravity(); //! No terminal velocity
 }
 
+/**
+ * Move the object using its forward velocity and gravity for as many frames as its update covers.
+ * Objects that can be updated at a reduced rate with OBJ_FLAG_UPDATE_LOD use this to keep their speed.
+ */
+void cur_obj_move_using_fvel_and_gravity_for_interval(void) {
+    f32 frames = gCurrentObjectUpdateInterval;
+
+    cur_obj_compute_vel_xz();
+    o->oPosX += (o->oVelX * frames);
+    o->oPosY += (o->oVelY * frames) + (o->oGravity * ((frames * (frames + 1.0f)) / 2.0f)); //! No terminal velocity
+    o->oPosZ += (o->oVelZ * frames);
+    o->oVelY += (o->oGravity * frames);
+}
+
 void obj_set_pos_relative(struct Object *obj, struct Object *other, f32 dleft, f32 dy, f32 dforward) {
     f32 facingZ = coss(other->oMoveAngleYaw);
     f32 facingX = sins(other->oMoveAngleYaw);
@@ -1655,13 +1775,13 @@ void cur_obj_spawn_particles(struct SpawnParticlesInfo *info) {
     s32 numParticles = info->count;
 
     // If there are a lot of objects already, limit the number of particles
-    if ((gPrevFrameObjectCount > (OBJECT_POOL_CAPACITY - 90)) && numParticles > 10) {
+    if ((gPrevFrameObjectCount > (gObjectPoolCapacity - 90)) && numParticles > 10) {
         numParticles = 10;
     }
 
     // We're close to running out of object slots, so don't spawn particles at
     // all
-    if (gPrevFrameObjectCount > (OBJECT_POOL_CAPACITY - 30)) {
+    if (gPrevFrameObjectCount > (gObjectPoolCapacity - 30)) {
         numParticles = 0;
     }
 
@@ -63,6 +63,10 @@ Gfx *geo_update_projectile_pos_from_parent(s32 callContext, UNUSED struct GraphN
 Gfx *geo_update_layer_transparency(s32 callContext, struct GraphNode *node, UNUSED void *context);
 Gfx *geo_switch_anim_state(s32 callContext, struct GraphNode *node, UNUSED void *context);
 Gfx *geo_switch_area(s32 callContext, struct GraphNode *node, UNUSED void *context);
+#ifdef ROOM_VISIBILITY_CULLING
+s32 room_is_visible_from_mario_room(s32 room);
+Gfx *geo_room_visibility(s32 callContext, struct GraphNode *node, UNUSED void *context);
+#endif
 void obj_update_pos_from_parent_transformation(Mat4 mtx, struct Object *obj);
 void create_transformation_from_matrices(Mat4 a0, Mat4 a1, Mat4 a2);
 void obj_set_held_state(struct Object *obj, const BehaviorScript *heldBehavior);
@@ -181,6 +185,7 @@ void cur_obj_update_floor_and_walls(void);
 void cur_obj_move_standard(s16 steepSlopeAngleDegrees);
 void cur_obj_move_using_vel_and_gravity(void);
 void cur_obj_move_using_fvel_and_gravity(void);
+void cur_obj_move_using_fvel_and_gravity_for_interval(void);
 s32 cur_obj_angle_to_home(void);
 void obj_set_gfx_pos_at_obj_pos(struct Object *obj1, struct Object *obj2);
 void obj_translate_local(struct Object *obj, s16 posIndex, s16 localTranslateIndex);
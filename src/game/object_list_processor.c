@@ -10,6 +10,7 @@
 #include "engine/surface_collision.h"
 #include "engine/surface_load.h"
 #include "engine/math_util.h"
+#include "game_init.h"
 #include "interaction.h"
 #include "level_update.h"
 #include "mario.h"
@@ -64,9 +65,17 @@ s16 gDebugInfoOverwrite[16][8];
 u32 gTimeStopState;
 
 /**
- * The pool that objects are allocated from.
+ * The pool that objects are allocated from, allocated from the main pool when the level is initialized.
  */
-struct Object gObjectPool[OBJECT_POOL_CAPACITY];
+struct Object *gObjectPool;
+s32 gObjectPoolCapacity;
+
+#ifdef PUPPYPRINT_DEBUG
+/**
+ * Occupancy of the object pool and its object lists since the level loaded.
+ */
+struct ObjectPoolStats gObjectPoolStats;
+#endif
 
 /**
  * A special object whose purpose is to act as a parent for macro objects.
@@ -104,6 +113,12 @@ struct Object *gMarioObject;
  */
 struct Object *gCurrentObject;
 
+/**
+ * The number of frames the current object's update covers. Objects updated at a reduced rate with
+ * OBJECT_UPDATE_LOD cover the frames until their next update, and scale their movement by this.
+ */
+s32 gCurrentObjectUpdateInterval = 1;
+
 /**
  * The next object behavior command to be executed.
  */
@@ -282,6 +297,51 @@ void bhv_mario_update(void) {
     }
 }
 
+#ifdef PUPPYPRINT_BEHAVIOR_PROFILER
+/**
+ * Update the current object, and add the time it took to its behavior's time in the behavior profiler.
+ */
+static void cur_obj_update_timed(void) {
+    const BehaviorScript *behavior = gCurrentObject->behavior;
+    u32 first = osGetCount();
+
+    cur_obj_update();
+
+    profiler_behavior_update(behavior, osGetCount() - first);
+}
+#else
+#define cur_obj_update_timed() cur_obj_update()
+#endif
+
+#ifdef OBJECT_UPDATE_LOD
+/**
+ * Get how many frames apart the current object should be updated, based on its distance from Mario.
+ */
+static s32 cur_obj_get_update_interval(void) {
+    if (!(o->oFlags & OBJ_FLAG_UPDATE_LOD)
+        || gMarioObject == NULL
+        || o->collisionData != NULL
+        || o->oHeldState != HELD_FREE
+    ) {
+        return 1;
+    }
+
+    Vec3f d;
+    vec3f_diff(d, &o->oPosVec, &gMarioObject->oPosVec);
+    f32 distSq = vec3_sumsq(d);
+
+    if (distSq > sqr(OBJECT_UPDATE_LOD_QUARTER_RATE_DIST)) {
+        return 4;
+    }
+
+    if (distSq > sqr(OBJECT_UPDATE_LOD_HALF_RATE_DIST)) {
+        return 2;
+    }
+
+    return 1;
+}
+#endif
+
 /**
  * Update every object that occurs after firstObj in the given object list,
  * including firstObj itself. Return the number of objects that were updated.
@@ -293,7 +353,23 @@ s32 update_objects_starting_at(struct ObjectNode *objList, struct ObjectNode *fi
         gCurrentObject = (struct Object *) firstObj;
 
         gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
-        cur_obj_update();
+#ifdef OBJECT_UPDATE_LOD
+        s32 interval = cur_obj_get_update_interval();
+
+        // Objects at the same rate take turns by their pool slot, so the same number are updated each frame.
+        if (((gGlobalTimer + (u32)(gCurrentObject - gObjectPool)) & (interval - 1)) == 0) {
+            gCurrentObjectUpdateInterval = interval;
+            cur_obj_update_timed();
+            gCurrentObjectUpdateInterval = 1;
+
+            // Count the frames until the next update, unless the timer was just reset by an action change.
+            if (interval > 1 && o->oTimer != 0) {
+                o->oTimer = MIN(o->oTimer + (interval - 1), 0x3FFFFFFF);
+            }
+        }
+#else
+        cur_obj_update_timed();
+#endif
 
         firstObj = firstObj->next;
         count++;
@@ -340,7 +416,7 @@ s32 update_objects_during_time_stop(struct ObjectNode *objList, struct ObjectNod
         // Only update if unfrozen
         if (unfrozen) {
             gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
-            cur_obj_update();
+            cur_obj_update_timed();
         } else {
             gCurrentObject->header.gfx.node.flags &= ~GRAPH_RENDER_HAS_ANIMATION;
         }
@@ -366,6 +442,13 @@ s32 update_objects_in_list(struct ObjectNode *objList) {
         count = update_objects_during_time_stop(objList, firstObj);
     }
 
+#ifdef PUPPYPRINT_DEBUG
+    u16 *highWater = &gObjectPoolStats.listHighWater[objList - gObjectLists];
+    if (count > *highWater) {
+        *highWater = count;
+    }
+#endif
+
     return count;
 }
 
@@ -506,6 +589,18 @@ void spawn_objects_from_info(UNUSED s32 unused, struct SpawnInfo *spawnInfo) {
     }
 }
 
+/**
+ * Allocate the object pool for the level being initialized.
+ * This must be done before clear_objects, since the previous level's pool has already been freed.
+ */
+void alloc_object_pool(s32 capacity) {
+    aggress(capacity > 0 && capacity <= OBJECT_POOL_MAX_CAPACITY, "Object pool size out of range");
+
+    gObjectPool = main_pool_alloc(capacity * sizeof(struct Object), MEMORY_POOL_LEFT);
+    aggress(gObjectPool != NULL, "Not enough memory for the object pool");
+    gObjectPoolCapacity = capacity;
+}
+
 /**
  * Clear objects, dynamic surfaces, and some miscellaneous level data used by objects.
  */
@@ -523,8 +618,9 @@ void clear_objects(void) {
 
     init_free_object_list();
     clear_object_lists(gObjectListArray);
+    clear_behavior_index();
 
-    for (i = 0; i < OBJECT_POOL_CAPACITY; i++) {
+    for (i = 0; i < gObjectPoolCapacity; i++) {
         gObjectPool[i].activeFlags = ACTIVE_FLAG_DEACTIVATED;
         geo_reset_object_node(&gObjectPool[i].header.gfx);
     }
@@ -532,6 +628,13 @@ void clear_objects(void) {
     gObjectMemoryPool = mem_pool_init(OBJECT_MEMORY_POOL, MEMORY_POOL_LEFT);
     gObjectLists = gObjectListArray;
 
+#ifdef PUPPYPRINT_DEBUG
+    bzero(&gObjectPoolStats, sizeof(gObjectPoolStats));
+#endif
+#ifdef PUPPYPRINT_BEHAVIOR_PROFILER
+    profiler_behavior_reset();
+#endif
+
     clear_dynamic_surfaces();
 }
 
@@ -620,7 +723,7 @@ UNUSED static u16 unused_get_elapsed_time(u64 *cycleCounts, s32 index) {
  * Change this function to use a linked list instead if you add any additional logic here whatsoever.
  */
 void clear_dynamic_surface_references(void) {
-    for (s32 i = 0; i < OBJECT_POOL_CAPACITY; i++) {
+    for (s32 i = 0; i < gObjectPoolCapacity; i++) {
         if (gObjectPool[i].oFloor && gObjectPool[i].oFloor->flags & SURFACE_FLAG_DYNAMIC) {
             gObjectPool[i].oFloor = NULL;
         }
@@ -649,6 +752,10 @@ void update_objects(UNUSED s32 unused) {
 
     // Update spawners and objects with surfaces
     update_terrain_objects();
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    // Remove the surfaces of platforms that didn't load their collision this frame before Mario uses them.
+    clear_unloaded_dynamic_surfaces(TRUE);
+#endif
 
     // If Mario was touching a moving platform at the end of last frame, apply
     // displacement now
@@ -667,6 +774,10 @@ void update_objects(UNUSED s32 unused) {
 
     // Unload any objects that have been deactivated
     unload_deactivated_objects();
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    // Remove the surfaces of any other objects that didn't load their collision this frame.
+    clear_unloaded_dynamic_surfaces(FALSE);
+#endif
 
     // Check if Mario is on a platform object and save this object
     update_mario_platform();
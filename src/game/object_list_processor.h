@@ -22,10 +22,15 @@ enum gTimeStopStateFlags {
 };
 
 /**
- * The maximum number of objects that can be loaded at once.
+ * The maximum number of objects that can be loaded at once, unless the level sets its own with OBJECT_POOL_SIZE.
  */
 #define OBJECT_POOL_CAPACITY 240
 
+/**
+ * The largest object pool a level can ask for with OBJECT_POOL_SIZE.
+ */
+#define OBJECT_POOL_MAX_CAPACITY 512
+
 /**
  * Every object is categorized into an object list, which controls the order
  * they are processed and which objects they can collide with.
@@ -78,7 +83,8 @@ extern s16 gDebugInfo[][8];
 extern s16 gDebugInfoOverwrite[][8];
 
 extern u32 gTimeStopState;
-extern struct Object gObjectPool[];
+extern struct Object *gObjectPool;
+extern s32 gObjectPoolCapacity;
 extern struct Object gMacroObjectDefaultParent;
 extern struct ObjectNode *gObjectLists;
 extern struct ObjectNode gFreeObjectList;
@@ -87,6 +93,7 @@ extern struct Object *gMarioObject;
 extern struct Object *gLuigiObject;
 extern struct Object *gCurrentObject;
 #define o gCurrentObject
+extern s32 gCurrentObjectUpdateInterval;
 
 extern const BehaviorScript *gCurBhvCommand;
 extern s16 gPrevFrameObjectCount;
@@ -98,6 +105,17 @@ extern s32 gNumStaticSurfaces;
 
 #define OBJECT_MEMORY_POOL 0x800
 
+#ifdef PUPPYPRINT_DEBUG
+struct ObjectPoolStats {
+    u16 used;                         // Objects currently allocated.
+    u16 usedHighWater;                // The most objects allocated at once since the level loaded.
+    u16 listHighWater[NUM_OBJ_LISTS]; // The most objects in each list at once, sampled once per frame.
+    u16 allocFailures[NUM_OBJ_LISTS]; // Allocations into each list that found the pool full.
+};
+
+extern struct ObjectPoolStats gObjectPoolStats;
+#endif
+
 extern struct MemoryPool *gObjectMemoryPool;
 
 enum CollisionFlags {
@@ -140,6 +158,7 @@ void bhv_mario_update(void);
 void set_object_respawn_info_bits(struct Object *obj, u8 bits);
 void unload_objects_from_area(UNUSED s32 unused, s32 areaIndex);
 void spawn_objects_from_info(UNUSED s32 unused, struct SpawnInfo *spawnInfo);
+void alloc_object_pool(s32 capacity);
 void clear_objects(void);
 void clear_dynamic_surface_references(void);
 void update_objects(UNUSED s32 unused);
@@ -29,6 +29,10 @@ u32 audio_subset_starts[AUDIO_SUBSET_SIZE];
 u32 audio_subset_tallies[AUDIO_SUBSET_SIZE];
 #endif
 
+#ifdef PUPPYPRINT_BEHAVIOR_PROFILER
+BehaviorProfileData behavior_profiling_data[BEHAVIOR_PROFILING_SIZE];
+#endif
+
 static void buffer_update(ProfileTimeData* data, u32 new, int buffer_index) {
     u32 old = data->counts[buffer_index];
     data->total -= old;
@@ -112,6 +116,59 @@ void profiler_collision_completed() {
 
 #endif
 
+#ifdef PUPPYPRINT_BEHAVIOR_PROFILER
+
+/**
+ * Add the time taken by one object's update to its behavior's time for this frame.
+ * Behaviors that don't fit in the table aren't timed.
+ */
+void profiler_behavior_update(const BehaviorScript *behavior, u32 time) {
+    u32 i = ((((uintptr_t) behavior >> 2) * 2654435761U) >> 16);
+
+    for (s32 probes = 0; probes < BEHAVIOR_PROFILING_SIZE; probes++, i++) {
+        BehaviorProfileData* cur_data = &behavior_profiling_data[i & (BEHAVIOR_PROFILING_SIZE - 1)];
+
+        if (cur_data->behavior == NULL) {
+            cur_data->behavior = behavior;
+        } else if (cur_data->behavior != behavior) {
+            continue;
+        }
+
+        cur_data->frameTime += time;
+        cur_data->frameInstances++;
+        if (time > cur_data->peak) {
+            cur_data->peak = time;
+        }
+        return;
+    }
+}
+
+void profiler_behavior_reset() {
+    bzero(behavior_profiling_data, sizeof(behavior_profiling_data));
+}
+
+static void update_behavior_timers() {
+    for (s32 i = 0; i < BEHAVIOR_PROFILING_SIZE; i++) {
+        BehaviorProfileData* cur_data = &behavior_profiling_data[i];
+
+        if (cur_data->behavior == NULL) {
+            continue;
+        }
+
+        buffer_update(&cur_data->time, cur_data->frameTime, profile_buffer_index);
+        cur_data->instances = cur_data->frameInstances;
+        cur_data->frameTime = 0;
+        cur_data->frameInstances = 0;
+
+        if (profile_buffer_index == PROFILING_BUFFER_SIZE - 1) {
+            cur_data->lastPeak = cur_data->peak;
+            cur_data->peak = 0;
+        }
+    }
+}
+
+#endif
+
 u32 profiler_get_delta(enum ProfilerDeltaTime which) {
     if (which == PROFILER_DELTA_COLLISION) {
         return collision_time;
@@ -325,6 +382,12 @@ void profiler_print_times() {
 }
 
 void profiler_frame_setup() {
+#ifdef PUPPYPRINT_BEHAVIOR_PROFILER
+    if (profile_buffer_index >= 0) {
+        update_behavior_timers();
+    }
+#endif
+
     profile_buffer_index++;
     preempted_time = 0;
 
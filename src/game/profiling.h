@@ -3,6 +3,7 @@
 
 #include <ultra64.h>
 #include "macros.h"
+#include "types.h"
 #include "config/config_debug.h"
 #include "config/config_safeguards.h"
 
@@ -89,6 +90,28 @@ typedef struct {
 } ProfileTimeData;
 extern ProfileTimeData all_profiling_data[PROFILER_TIME_COUNT];
 
+#ifdef PUPPYPRINT_BEHAVIOR_PROFILER
+/**
+ * The number of different behaviors the behavior profiler can time at once. Must be a power of two.
+ */
+#define BEHAVIOR_PROFILING_SIZE 64
+
+typedef struct {
+    const BehaviorScript *behavior;
+    ProfileTimeData time; // Cycles spent updating objects with this behavior each frame.
+    u32 frameTime;        // Cycles spent so far this frame.
+    u32 peak;             // The slowest single update since the buffer last wrapped.
+    u32 lastPeak;         // The slowest single update before the buffer last wrapped.
+    u16 frameInstances;   // Objects updated so far this frame.
+    u16 instances;        // Objects updated last frame.
+} BehaviorProfileData;
+
+extern BehaviorProfileData behavior_profiling_data[BEHAVIOR_PROFILING_SIZE];
+
+void profiler_behavior_update(const BehaviorScript *behavior, u32 time);
+void profiler_behavior_reset();
+#endif
+
 void profiler_update(enum ProfilerTime which, u32 delta);
 void profiler_print_times();
 void profiler_frame_setup();
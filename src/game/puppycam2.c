@@ -54,6 +54,21 @@ u16 gPuppyVolumeCount = 0;
 struct MemoryPool *gPuppyMemoryPool;
 s32 gPuppyError = 0;
 
+// Volumes are bucketed into a coarse grid over the level, so only the volumes near the target get checked.
+#define PUPPYCAM_VOLUME_GRID_SIZE 16
+#define PUPPYCAM_VOLUME_CELL_SIZE ((2 * LEVEL_BOUNDARY_MAX) / PUPPYCAM_VOLUME_GRID_SIZE)
+// Volumes covering more cells than this are checked wherever the target is instead.
+#define PUPPYCAM_VOLUME_MAX_CELLS 16
+
+static f32 sPuppyVolumeSin[MAX_PUPPYCAM_VOLUMES];
+static f32 sPuppyVolumeCos[MAX_PUPPYCAM_VOLUMES];
+// Each cell's volumes are the run of sPuppyVolumeCellEntries from its start to the next cell's start, in ascending order.
+static u16 sPuppyVolumeCellStart[(PUPPYCAM_VOLUME_GRID_SIZE * PUPPYCAM_VOLUME_GRID_SIZE) + 1];
+static u16 sPuppyVolumeCellEntries[MAX_PUPPYCAM_VOLUMES * PUPPYCAM_VOLUME_MAX_CELLS];
+static u16 sPuppyVolumeLarge[MAX_PUPPYCAM_VOLUMES];
+static u16 sPuppyVolumeLargeCount = 0;
+static u16 sPuppyVolumeIndexCount = 0; // How many volumes the index was last built with.
+
 #if defined(VERSION_EU)
 static unsigned char  gPCOptionStringsFR[][64] = {{NC_ANALOGUE_FR}, {NC_CAMX_FR}, {NC_INVERTX_FR}, {NC_CAMC_FR}, {NC_SCHEME_FR}, {NC_WIDE_FR}, {OPTION_LANGUAGE_FR}};
 static unsigned char  gPCOptionStringsDE[][64] = {{NC_ANALOGUE_DE}, {NC_CAMX_DE}, {NC_INVERTX_DE}, {NC_CAMC_DE}, {NC_SCHEME_DE}, {NC_WIDE_DE}, {OPTION_LANGUAGE_DE}};
@@ -482,6 +497,86 @@ void puppycam_reset_values(void) {
     gPuppyCam.splineProgress = 0;
 }
 
+// Finds the range of grid cells a puppycam volume could contain the target in.
+static void puppycam_get_volume_cell_range(s32 index, s32 *minCellX, s32 *maxCellX, s32 *minCellZ, s32 *maxCellZ) {
+    struct sPuppyVolume *volume = sPuppyVolumeStack[index];
+    f32 extentX, extentZ;
+
+    if (volume->shape == PUPPYVOLUME_SHAPE_BOX) {
+        // The lateral extents of the box once rotated.
+        extentX = (ABS(sPuppyVolumeCos[index]) * volume->radius[0]) + (ABS(sPuppyVolumeSin[index]) * volume->radius[2]);
+        extentZ = (ABS(sPuppyVolumeSin[index]) * volume->radius[0]) + (ABS(sPuppyVolumeCos[index]) * volume->radius[2]);
+    } else {
+        extentX = volume->radius[0];
+        extentZ = volume->radius[0];
+    }
+
+    // Pad by a unit, since the checks truncate the target's position.
+    *minCellX = ((volume->pos[0] - extentX - 1.0f + LEVEL_BOUNDARY_MAX) / PUPPYCAM_VOLUME_CELL_SIZE);
+    *maxCellX = ((volume->pos[0] + extentX + 1.0f + LEVEL_BOUNDARY_MAX) / PUPPYCAM_VOLUME_CELL_SIZE);
+    *minCellZ = ((volume->pos[2] - extentZ - 1.0f + LEVEL_BOUNDARY_MAX) / PUPPYCAM_VOLUME_CELL_SIZE);
+    *maxCellZ = ((volume->pos[2] + extentZ + 1.0f + LEVEL_BOUNDARY_MAX) / PUPPYCAM_VOLUME_CELL_SIZE);
+
+    *minCellX = CLAMP(*minCellX, 0, (PUPPYCAM_VOLUME_GRID_SIZE - 1));
+    *maxCellX = CLAMP(*maxCellX, 0, (PUPPYCAM_VOLUME_GRID_SIZE - 1));
+    *minCellZ = CLAMP(*minCellZ, 0, (PUPPYCAM_VOLUME_GRID_SIZE - 1));
+    *maxCellZ = CLAMP(*maxCellZ, 0, (PUPPYCAM_VOLUME_GRID_SIZE - 1));
+}
+
+// Returns whether a puppycam volume covers too many cells to be bucketed.
+static s32 puppycam_volume_is_large(s32 minCellX, s32 maxCellX, s32 minCellZ, s32 maxCellZ) {
+    return (((maxCellX - minCellX + 1) * (maxCellZ - minCellZ + 1)) > PUPPYCAM_VOLUME_MAX_CELLS);
+}
+
+// Precomputes the rotation of every puppycam volume and buckets them into the grid.
+static void puppycam_build_volume_index(void) {
+    u16 cursor[PUPPYCAM_VOLUME_GRID_SIZE * PUPPYCAM_VOLUME_GRID_SIZE];
+    s32 minCellX, maxCellX, minCellZ, maxCellZ;
+    s32 i, cellX, cellZ;
+
+    bzero(sPuppyVolumeCellStart, sizeof(sPuppyVolumeCellStart));
+    sPuppyVolumeLargeCount = 0;
+
+    // Count the volumes in each cell, offset by one so the counts become each cell's start once summed.
+    for (i = 0; i < gPuppyVolumeCount; i++) {
+        sPuppyVolumeSin[i] = sins(sPuppyVolumeStack[i]->rot);
+        sPuppyVolumeCos[i] = coss(sPuppyVolumeStack[i]->rot);
+
+        puppycam_get_volume_cell_range(i, &minCellX, &maxCellX, &minCellZ, &maxCellZ);
+        if (puppycam_volume_is_large(minCellX, maxCellX, minCellZ, maxCellZ)) {
+            sPuppyVolumeLarge[sPuppyVolumeLargeCount++] = i;
+            continue;
+        }
+
+        for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                sPuppyVolumeCellStart[(cellZ * PUPPYCAM_VOLUME_GRID_SIZE) + cellX + 1]++;
+            }
+        }
+    }
+
+    for (i = 0; i < (PUPPYCAM_VOLUME_GRID_SIZE * PUPPYCAM_VOLUME_GRID_SIZE); i++) {
+        sPuppyVolumeCellStart[i + 1] += sPuppyVolumeCellStart[i];
+        cursor[i] = sPuppyVolumeCellStart[i];
+    }
+
+    // Volumes are added in order, which keeps each cell's run in the order the volumes are applied in.
+    for (i = 0; i < gPuppyVolumeCount; i++) {
+        puppycam_get_volume_cell_range(i, &minCellX, &maxCellX, &minCellZ, &maxCellZ);
+        if (puppycam_volume_is_large(minCellX, maxCellX, minCellZ, maxCellZ)) {
+            continue;
+        }
+
+        for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                sPuppyVolumeCellEntries[cursor[(cellZ * PUPPYCAM_VOLUME_GRID_SIZE) + cellX]++] = i;
+            }
+        }
+    }
+
+    sPuppyVolumeIndexCount = gPuppyVolumeCount;
+}
+
 static void create_puppycam1_nodes(void) {
     u32 i, flagsAdd, flagsRemove;
     Vec3s pos, diff;
@@ -592,6 +687,7 @@ void puppycam_init(void) {
     gPuppyCam.debugFlags            = PUPPYDEBUG_LOCK_CONTROLS;
     puppycam_reset_values();
     create_puppycam1_nodes();
+    puppycam_build_volume_index();
 }
 
 void puppycam_input_pitch(void) {
@@ -999,55 +1095,54 @@ const struct sPuppyAngles puppyAnglesNull = {
     PUPPY_NULL,
 };
 
-// Checks the bounding box of a puppycam volume. If it's inside, then set the pointer to the current index.
-static s32 puppycam_check_volume_bounds(struct sPuppyVolume *volume, s32 index) {
+// Checks the bounding box of a puppycam volume. Returns the volume if the target is inside it.
+static struct sPuppyVolume *puppycam_check_volume_bounds(s32 index) {
+    struct sPuppyVolume *volume = sPuppyVolumeStack[index];
     s32 rel[3];
     s32 pos[2];
 
-    if (sPuppyVolumeStack[index]->room != gMarioCurrentRoom && sPuppyVolumeStack[index]->room != -1) {
-        return FALSE;
+    if (volume->room != gMarioCurrentRoom && volume->room != -1) {
+        return NULL;
     }
-    if (sPuppyVolumeStack[index]->shape == PUPPYVOLUME_SHAPE_BOX) {
+    if (volume->shape == PUPPYVOLUME_SHAPE_BOX) {
         // Fetch the relative position. to the triggeree.
-        vec3_diff(rel, sPuppyVolumeStack[index]->pos, &gPuppyCam.targetObj->oPosVec);
-        // Use the dark, forbidden arts of trig to rotate the volume.
-        pos[0] = rel[2] * sins(sPuppyVolumeStack[index]->rot) + rel[0] * coss(sPuppyVolumeStack[index]->rot);
-        pos[1] = rel[2] * coss(sPuppyVolumeStack[index]->rot) - rel[0] * sins(sPuppyVolumeStack[index]->rot);
+        vec3_diff(rel, volume->pos, &gPuppyCam.targetObj->oPosVec);
+        // Rotate into the volume's space, using the sine and cosine of its rotation found when it was indexed.
+        pos[0] = rel[2] * sPuppyVolumeSin[index] + rel[0] * sPuppyVolumeCos[index];
+        pos[1] = rel[2] * sPuppyVolumeCos[index] - rel[0] * sPuppyVolumeSin[index];
 #ifdef VISUAL_DEBUG
         Vec3f debugPos[2];
-        vec3f_set(debugPos[0], sPuppyVolumeStack[index]->pos[0],    sPuppyVolumeStack[index]->pos[1],    sPuppyVolumeStack[index]->pos[2]);
-        vec3f_set(debugPos[1], sPuppyVolumeStack[index]->radius[0], sPuppyVolumeStack[index]->radius[1], sPuppyVolumeStack[index]->radius[2]);
+        vec3f_set(debugPos[0], volume->pos[0],    volume->pos[1],    volume->pos[2]);
+        vec3f_set(debugPos[1], volume->radius[0], volume->radius[1], volume->radius[2]);
         debug_box_color(0x00FF0000);
-        debug_box_rot(debugPos[0], debugPos[1], sPuppyVolumeStack[index]->rot, DEBUG_SHAPE_BOX);
+        debug_box_rot(debugPos[0], debugPos[1], volume->rot, DEBUG_SHAPE_BOX);
 #endif
         // Now compare values.
-        if (-sPuppyVolumeStack[index]->radius[0] < pos[0] && pos[0] < sPuppyVolumeStack[index]->radius[0] &&
-            -sPuppyVolumeStack[index]->radius[1] < rel[1] && rel[1] < sPuppyVolumeStack[index]->radius[1] &&
-            -sPuppyVolumeStack[index]->radius[2] < pos[1] && pos[1] < sPuppyVolumeStack[index]->radius[2]) {
-            *volume = *sPuppyVolumeStack[index];
-            return TRUE;
+        if (-volume->radius[0] < pos[0] && pos[0] < volume->radius[0] &&
+            -volume->radius[1] < rel[1] && rel[1] < volume->radius[1] &&
+            -volume->radius[2] < pos[1] && pos[1] < volume->radius[2]) {
+            return volume;
         }
-    } else if (sPuppyVolumeStack[index]->shape == PUPPYVOLUME_SHAPE_CYLINDER) {
+    } else if (volume->shape == PUPPYVOLUME_SHAPE_CYLINDER) {
         // s16 dir;
-        vec3_diff(rel, sPuppyVolumeStack[index]->pos, &gPuppyCam.targetObj->oPosVec);
+        vec3_diff(rel, volume->pos, &gPuppyCam.targetObj->oPosVec);
         f32 dist = (sqr(rel[0]) + sqr(rel[2]));
 #ifdef VISUAL_DEBUG
         Vec3f debugPos[2];
-        vec3f_set(debugPos[0], sPuppyVolumeStack[index]->pos[0],    sPuppyVolumeStack[index]->pos[1],    sPuppyVolumeStack[index]->pos[2]);
-        vec3f_set(debugPos[1], sPuppyVolumeStack[index]->radius[0], sPuppyVolumeStack[index]->radius[1], sPuppyVolumeStack[index]->radius[2]);
+        vec3f_set(debugPos[0], volume->pos[0],    volume->pos[1],    volume->pos[2]);
+        vec3f_set(debugPos[1], volume->radius[0], volume->radius[1], volume->radius[2]);
         debug_box_color(0x00FF0000);
-        debug_box_rot(debugPos[0], debugPos[1], sPuppyVolumeStack[index]->rot, DEBUG_SHAPE_CYLINDER);
+        debug_box_rot(debugPos[0], debugPos[1], volume->rot, DEBUG_SHAPE_CYLINDER);
 #endif
-        f32 distCheck = (dist < sqr(sPuppyVolumeStack[index]->radius[0]));
+        f32 distCheck = (dist < sqr(volume->radius[0]));
 
-        if (-sPuppyVolumeStack[index]->radius[1] < rel[1] && rel[1] < sPuppyVolumeStack[index]->radius[1] && distCheck) {
-            *volume = *sPuppyVolumeStack[index];
-            return TRUE;
+        if (-volume->radius[1] < rel[1] && rel[1] < volume->radius[1] && distCheck) {
+            return volume;
         }
 
     }
 
-    return FALSE;
+    return NULL;
 }
 
 // Handles wall adjustment when wall kicking.
@@ -1289,62 +1384,104 @@ static void puppycam_projection(void) {
 
 }
 
+// Applies a puppycam volume the target is inside of.
+static void puppycam_apply_volume(struct sPuppyVolume *volume) {
+    // First applies pos and focus, for the most basic of volumes.
+    if (volume->angles != NULL) {
+        if (volume->angles->pos[0]   != PUPPY_NULL) gPuppyCam.pos[0]   = volume->angles->pos[0];
+        if (volume->angles->pos[1]   != PUPPY_NULL) gPuppyCam.pos[1]   = volume->angles->pos[1];
+        if (volume->angles->pos[2]   != PUPPY_NULL) gPuppyCam.pos[2]   = volume->angles->pos[2];
+
+        if (volume->angles->focus[0] != PUPPY_NULL) gPuppyCam.focus[0] = volume->angles->focus[0];
+        if (volume->angles->focus[1] != PUPPY_NULL) gPuppyCam.focus[1] = volume->angles->focus[1];
+        if (volume->angles->focus[2] != PUPPY_NULL) gPuppyCam.focus[2] = volume->angles->focus[2];
+
+        if (volume->angles->yaw != PUPPY_NULL) {
+            gPuppyCam.yawTarget = volume->angles->yaw;
+            gPuppyCam.yaw       = volume->angles->yaw;
+
+            gPuppyCam.flags &= ~PUPPYCAM_BEHAVIOUR_YAW_ROTATION;
+        } else {
+            gPuppyCam.yaw = atan2s(gPuppyCam.pos[2] - gPuppyCam.focus[2], gPuppyCam.pos[0] - gPuppyCam.focus[0]);
+        }
+
+        if (volume->angles->pitch != PUPPY_NULL) {
+            gPuppyCam.pitchTarget = volume->angles->pitch;
+            gPuppyCam.pitch       = volume->angles->pitch;
+
+            gPuppyCam.flags &= ~PUPPYCAM_BEHAVIOUR_PITCH_ROTATION;
+        }
+
+        if (volume->angles->zoom != PUPPY_NULL) {
+            gPuppyCam.zoomTarget = volume->angles->zoom;
+            gPuppyCam.zoom       = gPuppyCam.zoomTarget;
+        }
+    }
+
+    // Adds and removes behaviour flags, as set.
+    if (volume->flagsRemove) gPuppyCam.flags &= ~volume->flagsRemove;
+    if (volume->flagsAdd   ) gPuppyCam.flags |=  volume->flagsAdd;
+    if (volume->flagPersistance == PUPPYCAM_BEHAVIOUR_PERMANENT) {
+        // Adds and removes behaviour flags, as set.
+        if (volume->flagsRemove) gPuppyCam.intendedFlags &= ~volume->flagsRemove;
+        if (volume->flagsAdd   ) gPuppyCam.intendedFlags |=  volume->flagsAdd;
+    }
+
+    // Last and probably least, check if there's a function attached, and call it, if so.
+    if (volume->func) {
+        (volume->func)();
+    }
+}
+
+// Checks a puppycam volume, and applies it if the target is inside of it.
+static void puppycam_script_volume(s32 index) {
+    struct sPuppyVolume *volume = puppycam_check_volume_bounds(index);
+
+    if (volume != NULL) {
+        puppycam_apply_volume(volume);
+    }
+}
+
 // Calls any scripts to affect the camera, if applicable.
 static void puppycam_script(void) {
-    u16 i = 0;
-    struct sPuppyVolume volume;
+    s32 i;
 
     if (gPuppyVolumeCount == 0 || !gPuppyCam.targetObj) {
         return;
     }
-    for (i = 0; i < gPuppyVolumeCount; i++) {
-        if (puppycam_check_volume_bounds(&volume, i)) {
-            // First applies pos and focus, for the most basic of volumes.
-            if (volume.angles != NULL) {
-                if (volume.angles->pos[0]   != PUPPY_NULL) gPuppyCam.pos[0]   = volume.angles->pos[0];
-                if (volume.angles->pos[1]   != PUPPY_NULL) gPuppyCam.pos[1]   = volume.angles->pos[1];
-                if (volume.angles->pos[2]   != PUPPY_NULL) gPuppyCam.pos[2]   = volume.angles->pos[2];
-
-                if (volume.angles->focus[0] != PUPPY_NULL) gPuppyCam.focus[0] = volume.angles->focus[0];
-                if (volume.angles->focus[1] != PUPPY_NULL) gPuppyCam.focus[1] = volume.angles->focus[1];
-                if (volume.angles->focus[2] != PUPPY_NULL) gPuppyCam.focus[2] = volume.angles->focus[2];
-
-                if (volume.angles->yaw != PUPPY_NULL) {
-                    gPuppyCam.yawTarget = volume.angles->yaw;
-                    gPuppyCam.yaw       = volume.angles->yaw;
-
-                    gPuppyCam.flags &= ~PUPPYCAM_BEHAVIOUR_YAW_ROTATION;
-                } else {
-                    gPuppyCam.yaw = atan2s(gPuppyCam.pos[2] - gPuppyCam.focus[2], gPuppyCam.pos[0] - gPuppyCam.focus[0]);
-                }
 
-                if (volume.angles->pitch != PUPPY_NULL) {
-                    gPuppyCam.pitchTarget = volume.angles->pitch;
-                    gPuppyCam.pitch       = volume.angles->pitch;
+    // Volumes are only ever added or all freed, so a changed count means the index is stale.
+    if (sPuppyVolumeIndexCount != gPuppyVolumeCount) {
+        puppycam_build_volume_index();
+    }
 
-                    gPuppyCam.flags &= ~PUPPYCAM_BEHAVIOUR_PITCH_ROTATION;
-                }
+    s32 cellX = ((gPuppyCam.targetObj->oPosX + LEVEL_BOUNDARY_MAX) / PUPPYCAM_VOLUME_CELL_SIZE);
+    s32 cellZ = ((gPuppyCam.targetObj->oPosZ + LEVEL_BOUNDARY_MAX) / PUPPYCAM_VOLUME_CELL_SIZE);
 
-                if (volume.angles->zoom != PUPPY_NULL) {
-                    gPuppyCam.zoomTarget = volume.angles->zoom;
-                    gPuppyCam.zoom       = gPuppyCam.zoomTarget;
-                }
-            }
+    // Outside of the grid, just check everything.
+    if (cellX < 0 || cellX >= PUPPYCAM_VOLUME_GRID_SIZE || cellZ < 0 || cellZ >= PUPPYCAM_VOLUME_GRID_SIZE) {
+        for (i = 0; i < gPuppyVolumeCount; i++) {
+            puppycam_script_volume(i);
+        }
+        return;
+    }
 
-            // Adds and removes behaviour flags, as set.
-            if (volume.flagsRemove) gPuppyCam.flags &= ~volume.flagsRemove;
-            if (volume.flagsAdd   ) gPuppyCam.flags |=  volume.flagsAdd;
-            if (volume.flagPersistance == PUPPYCAM_BEHAVIOUR_PERMANENT) {
-                // Adds and removes behaviour flags, as set.
-                if (volume.flagsRemove) gPuppyCam.intendedFlags &= ~volume.flagsRemove;
-                if (volume.flagsAdd   ) gPuppyCam.intendedFlags |=  volume.flagsAdd;
-            }
+    s32 cell = ((cellZ * PUPPYCAM_VOLUME_GRID_SIZE) + cellX);
+    u16 *cellVolumes = &sPuppyVolumeCellEntries[sPuppyVolumeCellStart[cell]];
+    s32 numCellVolumes = (sPuppyVolumeCellStart[cell + 1] - sPuppyVolumeCellStart[cell]);
+    s32 cellIndex = 0;
+    s32 largeIndex = 0;
 
-            // Last and probably least, check if there's a function attached, and call it, if so.
-            if (volume.func) {
-                (volume.func)();
-            }
+    // Merge the cell's volumes with the large ones, so volumes are still applied in the order they were added.
+    while (cellIndex < numCellVolumes || largeIndex < sPuppyVolumeLargeCount) {
+        if (largeIndex >= sPuppyVolumeLargeCount
+            || (cellIndex < numCellVolumes && cellVolumes[cellIndex] < sPuppyVolumeLarge[largeIndex])) {
+            i = cellVolumes[cellIndex++];
+        } else {
+            i = sPuppyVolumeLarge[largeIndex++];
         }
+
+        puppycam_script_volume(i);
     }
 }
 
@@ -1374,11 +1511,11 @@ static void puppycam_collision(void) {
     vec3_diff(dirToCam, gPuppyCam.pos, target[0]);
     vec3f_normalize(dirToCam);
     // Get the vector from mario's head to the camera plus the extra check dist
-    Vec3f vecToCam;
-    vec3_scale_dest(vecToCam, dirToCam, colCheckDist);
+    Vec3f vecToCam[2];
+    vec3_scale_dest(vecToCam[0], dirToCam, colCheckDist);
+    vec3_copy(vecToCam[1], vecToCam[0]);
 
-    dist[0] = find_surface_on_ray(target[0], vecToCam, &surf[0], hitpos[0], RAYCAST_FIND_FLOOR | RAYCAST_FIND_CEIL | RAYCAST_FIND_WALL);
-    dist[1] = find_surface_on_ray(target[1], vecToCam, &surf[1], hitpos[1], RAYCAST_FIND_FLOOR | RAYCAST_FIND_CEIL | RAYCAST_FIND_WALL);
+    find_surfaces_on_rays(2, target, vecToCam, surf, hitpos, dist, RAYCAST_FIND_FLOOR | RAYCAST_FIND_CEIL | RAYCAST_FIND_WALL);
 
     // set collision distance to the current distance from mario to cam
     gPuppyCam.collisionDistance = colCheckDist;
@@ -45,6 +45,7 @@ a modern game engine's developer's console.
 #include "audio/external.h"
 #include "audio/heap.h"
 #include "audio/load.h"
+#include "audio/playback.h"
 #include "hud.h"
 #include "debug_box.h"
 #include "color_presets.h"
@@ -415,6 +416,21 @@ static void print_audio_overview(void) {
             "In <COL_FFFF1FFF>profiling.h<COL_-------->.", PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
 #endif
 
+    sprintf(textBytes, "Sample DMAs\nHits: %d\nMisses: %d\nEvictions: %d\nStream underruns: %d",
+            gPuppyCallCounter.sample_dma_hit,
+            gPuppyCallCounter.sample_dma_miss,
+            gPuppyCallCounter.sample_dma_evict,
+            gPuppyCallCounter.sample_stream_underrun
+    );
+#ifdef ADAPTIVE_NOTE_CAP
+    sprintf(&textBytes[strlen(textBytes)], "\n\nNote cap: %d/%d\nStolen notes: %d",
+            gNoteCap, gMaxSimultaneousNotes,
+            gPuppyCallCounter.note_steal
+    );
+#endif
+    print_set_envcolour(255, 255, 255, 255);
+    print_small_text_light(SCREEN_WIDTH - 12, 6, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+
     print_audio_ram_overview(x, textBytes);
 }
 
@@ -488,6 +504,84 @@ void puppyprint_render_collision(void) {
 #endif
 }
 
+static const char *sObjectListNames[NUM_OBJ_LISTS] = {
+    [OBJ_LIST_PLAYER]      = "Player",
+    [OBJ_LIST_UNUSED_1]    = "Unused 1",
+    [OBJ_LIST_DESTRUCTIVE] = "Destructive",
+    [OBJ_LIST_UNUSED_3]    = "Unused 3",
+    [OBJ_LIST_GENACTOR]    = "Gen Actor",
+    [OBJ_LIST_PUSHABLE]    = "Pushable",
+    [OBJ_LIST_LEVEL]       = "Level",
+    [OBJ_LIST_UNUSED_7]    = "Unused 7",
+    [OBJ_LIST_DEFAULT]     = "Default",
+    [OBJ_LIST_SURFACE]     = "Surface",
+    [OBJ_LIST_POLELIKE]    = "Polelike",
+    [OBJ_LIST_SPAWNER]     = "Spawner",
+    [OBJ_LIST_UNIMPORTANT] = "Unimportant",
+};
+
+void puppyprint_render_object_pool(void) {
+    char textBytes[64];
+    s32 y = 60;
+
+    sprintf(textBytes, "Object Pool: %d/%d (Peak %d)", gObjectPoolStats.used, gObjectPoolCapacity, gObjectPoolStats.usedHighWater);
+    print_small_text_light(SCREEN_WIDTH - 16, 36, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+    print_small_text_light(SCREEN_WIDTH - 16, 48, "List: Peak / Failed", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+
+    for (s32 i = 0; i < NUM_OBJ_LISTS; i++) {
+        if (gObjectPoolStats.listHighWater[i] == 0 && gObjectPoolStats.allocFailures[i] == 0) {
+            continue;
+        }
+
+        sprintf(textBytes, "%s: %d / %d", sObjectListNames[i], gObjectPoolStats.listHighWater[i], gObjectPoolStats.allocFailures[i]);
+        print_small_text_light(SCREEN_WIDTH - 16, y, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+        y += 10;
+    }
+}
+
+#ifdef PUPPYPRINT_BEHAVIOR_PROFILER
+#define NUM_LISTED_BEHAVIORS 16
+
+void puppyprint_render_behavior_profiler(void) {
+    BehaviorProfileData *listed[NUM_LISTED_BEHAVIORS];
+    s32 numListed = 0;
+    char textBytes[64];
+    s32 i, j;
+
+    // Keep the most expensive behaviors, sorted by their average time per frame.
+    for (i = 0; i < BEHAVIOR_PROFILING_SIZE; i++) {
+        BehaviorProfileData *data = &behavior_profiling_data[i];
+
+        if (data->behavior == NULL || data->time.total == 0) {
+            continue;
+        }
+
+        for (j = numListed; j > 0 && listed[j - 1]->time.total < data->time.total; j--) {
+            if (j < NUM_LISTED_BEHAVIORS) {
+                listed[j] = listed[j - 1];
+            }
+        }
+
+        if (j < NUM_LISTED_BEHAVIORS) {
+            listed[j] = data;
+            if (numListed < NUM_LISTED_BEHAVIORS) {
+                numListed++;
+            }
+        }
+    }
+
+    print_small_text_light(SCREEN_WIDTH - 16, 36, "Behavior: Avg / Max / Objects", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+
+    for (i = 0; i < numListed; i++) {
+        sprintf(textBytes, "%08X: %d / %d / %d", (u32) listed[i]->behavior,
+                CYCLE_CONV(listed[i]->time.total / PROFILING_BUFFER_SIZE),
+                CYCLE_CONV(MAX(listed[i]->peak, listed[i]->lastPeak)),
+                listed[i]->instances);
+        print_small_text_light(SCREEN_WIDTH - 16, 48 + (i * 10), textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+    }
+}
+#endif
+
 extern void print_fps(s32 x, s32 y);
 
 void print_basic_profiling(void) {
@@ -506,8 +600,14 @@ void print_basic_profiling(void) {
 void puppyprint_render_standard(void) {
     char textBytes[128];
 
+#ifdef MATRIX_CACHE
+    sprintf(textBytes, "Matrix Muls: %d\nMatrices Reused: %d\nCollision Checks\nFloors: %d\nWalls: %d\nCeilings: %d\n Water: %d\nRaycasts: %d",
+            gPuppyCallCounter.matrix,
+            gPuppyCallCounter.matrix_cache_hit,
+#else
     sprintf(textBytes, "Matrix Muls: %d\n\nCollision Checks\nFloors: %d\nWalls: %d\nCeilings: %d\n Water: %d\nRaycasts: %d",
             gPuppyCallCounter.matrix,
+#endif
             gPuppyCallCounter.collision_floor,
             gPuppyCallCounter.collision_wall,
             gPuppyCallCounter.collision_ceil,
@@ -515,6 +615,26 @@ void puppyprint_render_standard(void) {
             gPuppyCallCounter.collision_raycast
     );
     print_small_text_light(SCREEN_WIDTH-16, 32, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+#ifdef COLLISION_QUERY_CACHE
+    sprintf(textBytes, "Query Cache\nHits: %d\nMisses: %d",
+            gPuppyCallCounter.collision_cache_hit,
+            gPuppyCallCounter.collision_cache_miss
+    );
+    print_small_text_light(SCREEN_WIDTH-16, 124, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+#endif
+#ifdef ANIMATION_DECODE_CACHE
+    sprintf(textBytes, "Anim Cache\nHits: %d\nMisses: %d",
+            gPuppyCallCounter.anim_cache_hit,
+            gPuppyCallCounter.anim_cache_miss
+    );
+    print_small_text_light(SCREEN_WIDTH-16, 160, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+#endif
+#ifdef SORT_DISPLAY_LISTS_BY_MATERIAL
+    sprintf(textBytes, "Material Sort\nChanges Saved: %d",
+            gPuppyCallCounter.material_changes_saved
+    );
+    print_small_text_light(SCREEN_WIDTH-16, 196, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
+#endif
 }
 
 void puppyprint_render_minimal(void) {
@@ -996,7 +1116,7 @@ void puppyprint_render_general_vars(void) {
 
     sprintf(textBytes, "World\n\nObjects: %d/%d\n\nLevel ID: %d\nCourse ID: %d\nArea ID: %d\nRoom ID: %d\n\nInteract:   \n0x%08X\nWarp: 0x%02X", 
             gObjectCounter, 
-            OBJECT_POOL_CAPACITY,
+            gObjectPoolCapacity,
             gCurrLevelNum,
             gCurrCourseNum,
             gCurrAreaIndex,
@@ -1037,6 +1157,10 @@ struct PuppyPrintPage ppPages[] = {
     [PUPPYPRINT_PAGE_AUDIO]         = {&print_audio_overview,           "Audio"},
     [PUPPYPRINT_PAGE_RAM]           = {&print_ram_overview,             "Segments"},
     [PUPPYPRINT_PAGE_COLLISION]     = {&puppyprint_render_collision,    "Collision"},
+    [PUPPYPRINT_PAGE_OBJECTS]       = {&puppyprint_render_object_pool,  "Objects"},
+#ifdef PUPPYPRINT_BEHAVIOR_PROFILER
+    [PUPPYPRINT_PAGE_BEHAVIORS]     = {&puppyprint_render_behavior_profiler, "Behaviors"},
+#endif
     [PUPPYPRINT_PAGE_LOG]           = {&print_console_log,              "Log"},
     [PUPPYPRINT_PAGE_LEVEL_SELECT]  = {&puppyprint_level_select_menu,   "Level Select"},
     [PUPPYPRINT_PAGE_COVERAGE]      = {&render_coverage_map,            "Coverage"},
@@ -49,6 +49,17 @@ struct CallCounter {
     u16 collision_ceil;
     u16 collision_water;
     u16 collision_raycast;
+    u16 collision_cache_hit;
+    u16 collision_cache_miss;
+    u16 anim_cache_hit;
+    u16 anim_cache_miss;
+    u16 material_changes_saved;
+    u16 matrix_cache_hit;
+    u16 sample_dma_hit;
+    u16 sample_dma_miss;
+    u16 sample_dma_evict;
+    u16 sample_stream_underrun;
+    u16 note_steal;
     u16 matrix;
 };
 
@@ -92,6 +103,10 @@ enum PPPages {
     PUPPYPRINT_PAGE_AUDIO,
     PUPPYPRINT_PAGE_RAM,
     PUPPYPRINT_PAGE_COLLISION,
+    PUPPYPRINT_PAGE_OBJECTS,
+#ifdef PUPPYPRINT_BEHAVIOR_PROFILER
+    PUPPYPRINT_PAGE_BEHAVIORS,
+#endif
     PUPPYPRINT_PAGE_LOG,
     PUPPYPRINT_PAGE_LEVEL_SELECT,
     PUPPYPRINT_PAGE_COVERAGE,
@@ -2,6 +2,8 @@
 
 #include "area.h"
 #include "engine/math_util.h"
+#include "engine/geo_layout.h"
+#include "engine/surface_collision.h"
 #include "game_init.h"
 #include "gfx_dimensions.h"
 #include "main.h"
@@ -14,6 +16,8 @@
 #include "puppyprint.h"
 #include "debug_box.h"
 #include "level_update.h"
+#include "object_helpers.h"
+#include "object_list_processor.h"
 #include "behavior_data.h"
 #include "string.h"
 #include "color_presets.h"
@@ -248,6 +252,78 @@ Mtx identityMatrixWorldScale = {{
      0x00000000,                            LOWER_FIXED(1.0f)               <<  0}
 }};
 
+#ifdef SORT_DISPLAY_LISTS_BY_MATERIAL
+// Layers whose display lists can be drawn in any order, since they're z-buffered and don't blend.
+#define LAYER_IS_SORTABLE(layer) (((layer) == LAYER_OPAQUE) || ((layer) == LAYER_OPAQUE_INTER) || ((layer) == LAYER_ALPHA))
+
+/**
+ * Get the key display lists are grouped by. Fast64 display lists begin by calling their material's display list,
+ * so lists sharing a material share the first call. Otherwise, only the same display list is known to share its state.
+ */
+static uintptr_t get_display_list_material_key(void *displayList) {
+    Gfx *gfx = ((uintptr_t) displayList & 0x80000000) ? displayList : segmented_to_virtual(displayList);
+
+    if (_SHIFTR(gfx->words.w0, 24, 8) == (u8) G_DL) {
+        return gfx->words.w1;
+    }
+    return (uintptr_t) displayList;
+}
+
+/**
+ * Count the number of times the material key changes along a display list node list.
+ */
+static s32 count_material_changes(struct DisplayListNode *list) {
+    s32 changes = 0;
+
+    for (; list != NULL && list->next != NULL; list = list->next) {
+        if (list->materialKey != list->next->materialKey) {
+            changes++;
+        }
+    }
+    return changes;
+}
+
+/**
+ * Stable merge sort of a display list node list by material key, so lists sharing a material are drawn together.
+ */
+static struct DisplayListNode *sort_display_lists_by_material(struct DisplayListNode *list) {
+    struct DisplayListNode *slow, *fast, *second;
+    struct DisplayListNode head;
+    struct DisplayListNode *tail = &head;
+
+    if (list == NULL || list->next == NULL) {
+        return list;
+    }
+
+    // Split the list in half.
+    slow = list;
+    fast = list->next;
+    while (fast != NULL && fast->next != NULL) {
+        slow = slow->next;
+        fast = fast->next->next;
+    }
+    second = slow->next;
+    slow->next = NULL;
+
+    list = sort_display_lists_by_material(list);
+    second = sort_display_lists_by_material(second);
+
+    while (list != NULL && second != NULL) {
+        if (second->materialKey < list->materialKey) {
+            tail->next = second;
+            second = second->next;
+        } else {
+            tail->next = list;
+            list = list->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = (list != NULL) ? list : second;
+
+    return head.next;
+}
+#endif
+
 /**
  * Process a master list node. This has been modified, so now it runs twice, for each microcode.
  * It iterates through the first 5 layers of if the first index using F3DLX2.Rej, then it switches
@@ -268,6 +344,23 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
     struct RenderModeContainer *mode2List = &renderModeTable_2Cycle[enableZBuffer];
     Gfx *tempGfxHead = gDisplayListHead;
 
+#ifdef SORT_DISPLAY_LISTS_BY_MATERIAL
+    // Without the z-buffer, draw order decides what's in front.
+    if (enableZBuffer) {
+        for (currLayer = LAYER_FIRST; currLayer < LAYER_COUNT; currLayer++) {
+            if (LAYER_IS_SORTABLE(currLayer) && node->listHeads[currLayer] != NULL) {
+#ifdef PUPPYPRINT_DEBUG
+                s32 changes = count_material_changes(node->listHeads[currLayer]);
+#endif
+                node->listHeads[currLayer] = sort_display_lists_by_material(node->listHeads[currLayer]);
+#ifdef PUPPYPRINT_DEBUG
+                gPuppyCallCounter.material_changes_saved += (changes - count_material_changes(node->listHeads[currLayer]));
+#endif
+            }
+        }
+    }
+#endif
+
     // Loop through the render phases
     for (phaseIndex = RENDER_PHASE_FIRST; phaseIndex < finalPhase; phaseIndex++) {
         if (enableZBuffer) {
@@ -374,6 +467,11 @@ void geo_append_display_list(void *displayList, s32 layer) {
         listNode->transform = gMatStackFixed[gMatStackIndex];
         listNode->displayList = displayList;
         listNode->next = NULL;
+#ifdef SORT_DISPLAY_LISTS_BY_MATERIAL
+        if (LAYER_IS_SORTABLE(layer)) {
+            listNode->materialKey = get_display_list_material_key(displayList);
+        }
+#endif
         if (gCurGraphNodeMasterList->listHeads[layer] == NULL) {
             gCurGraphNodeMasterList->listHeads[layer] = listNode;
         } else {
@@ -390,6 +488,78 @@ static void inc_mat_stack() {
     gMatStackFixed[gMatStackIndex] = mtx;
 }
 
+#ifdef MATRIX_CACHE
+/**
+ * The fixed point matrices of a node or object that keeps the same transform between frames.
+ * The display list being drawn may still be using the current matrix, so a changed matrix is written to the other one.
+ */
+struct MatrixCacheEntry {
+    Mtx mtx[2];
+    Mat4 src; // The matrix the current fixed point matrix was converted from.
+    void *site;
+    u32 frame; // The last frame the current fixed point matrix was written or used on.
+    u8 current;
+};
+
+static struct MatrixCacheEntry *sMatrixCache = NULL;
+
+/**
+ * Allocate the matrix cache. It lives for the whole game, since display lists from the last frame can still be using it
+ * when a level is unloaded. Without it, every matrix is converted as usual.
+ */
+void alloc_matrix_cache(void) {
+    sMatrixCache = main_pool_alloc(MATRIX_CACHE_SIZE * sizeof(struct MatrixCacheEntry), MEMORY_POOL_LEFT);
+    if (sMatrixCache != NULL) {
+        bzero(sMatrixCache, MATRIX_CACHE_SIZE * sizeof(struct MatrixCacheEntry));
+    }
+}
+
+/**
+ * inc_mat_stack for a node or object whose transform is usually the same as last frame.
+ * If the new matrix is the same as the one last converted for this site, its fixed point matrix is reused
+ * instead of being converted into the display list pool again.
+ */
+static void inc_mat_stack_cached(void *site) {
+    struct MatrixCacheEntry *entry;
+
+    if (sMatrixCache == NULL || site == NULL) {
+        inc_mat_stack();
+        return;
+    }
+
+    entry = &sMatrixCache[((((uintptr_t) site >> 2) * 2654435761U) >> 16) & (MATRIX_CACHE_SIZE - 1)];
+    gMatStackIndex++;
+
+    if (entry->site != site || bcmp(entry->src, gMatStack[gMatStackIndex], sizeof(Mat4)) != 0) {
+        if (entry->frame == gGlobalTimer) {
+            // The entry was already used this frame, so both of its matrices may be in use.
+            gMatStackIndex--;
+            inc_mat_stack();
+            return;
+        }
+
+        entry->site = site;
+        entry->frame = gGlobalTimer;
+        entry->current ^= 1;
+        mtxf_copy(entry->src, gMatStack[gMatStackIndex]);
+        mtxf_to_mtx(&entry->mtx[entry->current], gMatStack[gMatStackIndex]);
+    } else {
+        // The other matrix can only be overwritten once no display list still in flight uses this one.
+        entry->frame = gGlobalTimer;
+#ifdef PUPPYPRINT_DEBUG
+        gPuppyCallCounter.matrix_cache_hit++;
+#endif
+    }
+
+    gMatStackFixed[gMatStackIndex] = &entry->mtx[entry->current];
+}
+
+// Nodes outside of objects are only drawn once a frame, so their transforms can be cached by node.
+#define LEVEL_NODE_MATRIX_SITE(node) (((gCurGraphNodeObject == NULL) && (gCurGraphNodeHeldObject == NULL)) ? (void *) (node) : NULL)
+#else
+#define inc_mat_stack_cached(site) inc_mat_stack()
+#endif
+
 static void append_dl_and_return(struct GraphNodeDisplayList *node) {
     if (node->displayList != NULL) {
         geo_append_display_list(node->displayList, GET_GRAPH_NODE_LAYER(node->node.flags));
@@ -626,7 +796,7 @@ void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node)
     vec3s_to_vec3f(translation, node->translation);
     mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
-    inc_mat_stack();
+    inc_mat_stack_cached(LEVEL_NODE_MATRIX_SITE(node));
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -641,7 +811,7 @@ void geo_process_translation(struct GraphNodeTranslation *node) {
     vec3s_to_vec3f(translation, node->translation);
     mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
-    inc_mat_stack();
+    inc_mat_stack_cached(LEVEL_NODE_MATRIX_SITE(node));
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -653,7 +823,7 @@ void geo_process_translation(struct GraphNodeTranslation *node) {
 void geo_process_rotation(struct GraphNodeRotation *node) {
     mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
-    inc_mat_stack();
+    inc_mat_stack_cached(LEVEL_NODE_MATRIX_SITE(node));
     append_dl_and_return(((struct GraphNodeDisplayList *)node));
 }
 
@@ -668,7 +838,7 @@ void geo_process_scale(struct GraphNodeScale *node) {
     vec3f_set(scaleVec, node->scale, node->scale, node->scale);
     mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
 
-    inc_mat_stack();
+    inc_mat_stack_cached(LEVEL_NODE_MATRIX_SITE(node));
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -763,37 +933,25 @@ void geo_process_background(struct GraphNodeBackground *node) {
 }
 
 /**
- * Render an animated part. The current animation state is not part of the node
- * but set in global variables. If an animated part is skipped, everything afterwards desyncs.
+ * Read the translation and rotation of the current animated part from the current animation,
+ * and advance the animation state to the next part. Translation that isn't animated is left as zero.
  */
-void geo_process_animated_part(struct GraphNodeAnimatedPart *node) {
-    Vec3s rotation = { 0, 0, 0 };
-    Vec3f translation = { node->translation[0], node->translation[1], node->translation[2] };
-
+static void retrieve_animated_part_values(Vec3s translation, Vec3s rotation) {
     if (gCurrAnimType == ANIM_TYPE_TRANSLATION) {
-        translation[0] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                          * gCurrAnimTranslationMultiplier;
-        translation[1] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                          * gCurrAnimTranslationMultiplier;
-        translation[2] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                          * gCurrAnimTranslationMultiplier;
+        translation[0] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
+        translation[1] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
+        translation[2] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
         gCurrAnimType = ANIM_TYPE_ROTATION;
     } else {
         if (gCurrAnimType == ANIM_TYPE_LATERAL_TRANSLATION) {
-            translation[0] +=
-                gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                * gCurrAnimTranslationMultiplier;
+            translation[0] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
             gCurrAnimAttribute += 2;
-            translation[2] +=
-                gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                * gCurrAnimTranslationMultiplier;
+            translation[2] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
             gCurrAnimType = ANIM_TYPE_ROTATION;
         } else {
             if (gCurrAnimType == ANIM_TYPE_VERTICAL_TRANSLATION) {
                 gCurrAnimAttribute += 2;
-                translation[1] +=
-                    gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
-                    * gCurrAnimTranslationMultiplier;
+                translation[1] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
                 gCurrAnimAttribute += 2;
                 gCurrAnimType = ANIM_TYPE_ROTATION;
             } else if (gCurrAnimType == ANIM_TYPE_NO_TRANSLATION) {
@@ -808,6 +966,92 @@ void geo_process_animated_part(struct GraphNodeAnimatedPart *node) {
         rotation[1] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
         rotation[2] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
     }
+}
+
+#ifdef ANIMATION_DECODE_CACHE
+// Must be a power of two.
+#define ANIMATION_DECODE_CACHE_SIZE 128
+
+struct AnimationDecodeCacheEntry {
+    u16 *attribute;     // The animation attributes of the part.
+    u16 *nextAttribute; // The animation attributes of the next part.
+    u32 generation;
+    s16 frame;
+    s16 animType;
+    Vec3s translation;
+    Vec3f rotation[3]; // The rotation rows of the part's matrix.
+};
+
+static struct AnimationDecodeCacheEntry sAnimationDecodeCache[ANIMATION_DECODE_CACHE_SIZE];
+
+/**
+ * Entries from an older generation are stale. Starts at 1 so zeroed entries are never valid.
+ * Animations can be loaded into the same buffer between frames, so every frame starts a new generation.
+ */
+static u32 sAnimationDecodeCacheGeneration = 1;
+
+/**
+ * Get the decoded translation and rotation of the current animated part, decoding it if no other object
+ * has already decoded the same part on the same frame this frame. Advances the animation state to the next part.
+ */
+static struct AnimationDecodeCacheEntry *get_animation_decode_cache_entry(void) {
+    u32 index = (((((uintptr_t) gCurrAnimAttribute >> 2) ^ ((u32) gCurrAnimFrame << 12)) * 2654435761U) >> 16) & (ANIMATION_DECODE_CACHE_SIZE - 1);
+    struct AnimationDecodeCacheEntry *entry = &sAnimationDecodeCache[index];
+
+    if (entry->generation == sAnimationDecodeCacheGeneration
+        && entry->attribute == gCurrAnimAttribute
+        && entry->frame == gCurrAnimFrame
+        && entry->animType == gCurrAnimType) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.anim_cache_hit);
+        gCurrAnimAttribute = entry->nextAttribute;
+        gCurrAnimType = ANIM_TYPE_ROTATION;
+        return entry;
+    }
+
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.anim_cache_miss);
+    Vec3s rotation = { 0, 0, 0 };
+
+    entry->attribute = gCurrAnimAttribute;
+    entry->frame = gCurrAnimFrame;
+    entry->animType = gCurrAnimType;
+    entry->generation = sAnimationDecodeCacheGeneration;
+    vec3_zero(entry->translation);
+    retrieve_animated_part_values(entry->translation, rotation);
+    entry->nextAttribute = gCurrAnimAttribute;
+    mtxf_rotate_xyz_rows(entry->rotation, rotation);
+
+    return entry;
+}
+#endif
+
+/**
+ * Render an animated part. The current animation state is not part of the node
+ * but set in global variables. If an animated part is skipped, everything afterwards desyncs.
+ */
+void geo_process_animated_part(struct GraphNodeAnimatedPart *node) {
+    Vec3s rotation = { 0, 0, 0 };
+    Vec3s animTranslation = { 0, 0, 0 };
+    Vec3f translation = { node->translation[0], node->translation[1], node->translation[2] };
+
+#ifdef ANIMATION_DECODE_CACHE
+    if (gCurrAnimType != ANIM_TYPE_NONE) {
+        struct AnimationDecodeCacheEntry *entry = get_animation_decode_cache_entry();
+
+        translation[0] += entry->translation[0] * gCurrAnimTranslationMultiplier;
+        translation[1] += entry->translation[1] * gCurrAnimTranslationMultiplier;
+        translation[2] += entry->translation[2] * gCurrAnimTranslationMultiplier;
+        mtxf_rows_translate_and_mul(entry->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+
+        inc_mat_stack();
+        append_dl_and_return(((struct GraphNodeDisplayList *)node));
+        return;
+    }
+#endif
+
+    retrieve_animated_part_values(animTranslation, rotation);
+    translation[0] += animTranslation[0] * gCurrAnimTranslationMultiplier;
+    translation[1] += animTranslation[1] * gCurrAnimTranslationMultiplier;
+    translation[2] += animTranslation[2] * gCurrAnimTranslationMultiplier;
 
     mtxf_rotate_xyz_and_translate_and_mul(rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
@@ -1032,12 +1276,101 @@ void visualise_object_hitbox(struct Object *node) {
 }
 #endif
 
+#ifdef ROOM_VISIBILITY_CULLING
+/**
+ * Whether an object's room may be visible from Mario's room. Objects without a room look up the room under them
+ * every 16 frames, spread over the frames by their slot in the object pool.
+ */
+static s32 obj_room_is_visible(struct Object *obj) {
+    s32 room = obj->oRoom;
+
+    if (gCurrentArea == NULL || gCurrentArea->roomVisibility == NULL) {
+        return TRUE;
+    }
+
+    if (room == -1) {
+        if (((gGlobalTimer + (u32) (obj - gObjectPool)) & 15) == 0) {
+            obj->visibilityRoom = get_room_at_pos(obj->oPosX, obj->oPosY, obj->oPosZ);
+        }
+        room = obj->visibilityRoom;
+    }
+
+    return room_is_visible_from_mario_room(room);
+}
+#endif
+
+#ifdef OBJECT_CULLING_PREPASS
+// Whether culledByPrepass is up to date for the objects currently being processed.
+static s32 sObjectCullingPrepassValid = FALSE;
+
+/**
+ * Finds the camera space position of every active object in the current area, and whether it's in view,
+ * in one pass before the objects are processed. Objects found to be out of view don't build their transform.
+ * The translation is found the same way as in geo_process_object, with the object parent's matrix on top of the stack.
+ */
+static void geo_cull_objects(void) {
+    struct Object *firstObj = (struct Object *) gObjParentGraphNode.children;
+    struct Object *obj = firstObj;
+    Vec3f pos;
+
+    if (firstObj == NULL) {
+        return;
+    }
+
+    do {
+        struct GraphNodeObject *gfx = &obj->header.gfx;
+
+        if ((gfx->node.flags & GRAPH_RENDER_ACTIVE) && gfx->areaIndex == gCurGraphNodeRoot->areaIndex) {
+            if (gfx->throwMatrix != NULL) {
+                vec3f_copy(pos, (*gfx->throwMatrix)[3]);
+            } else if (gfx->node.flags & GRAPH_RENDER_BILLBOARD) {
+                vec3f_sum(pos, gfx->pos, gMatStack[gMatStackIndex][3]);
+            } else {
+                vec3f_copy(pos, gfx->pos);
+            }
+            linear_mtxf_mul_vec3f_and_translate(gCameraTransform, gfx->cameraToObject, pos);
+
+            obj->culledByPrepass = ((gfx->node.flags & GRAPH_RENDER_INVISIBLE) || !obj_is_in_view(gfx));
+#ifdef ROOM_VISIBILITY_CULLING
+            obj->culledByPrepass |= !obj_room_is_visible(obj);
+#endif
+        } else {
+            obj->culledByPrepass = FALSE;
+        }
+
+        obj = (struct Object *) gfx->node.next;
+    } while (obj != firstObj);
+}
+#endif
+
 /**
  * Process an object node.
  */
 void geo_process_object(struct Object *node) {
+#ifdef OBJECT_CULLING_PREPASS
+    // Objects that were culled by the pre-pass already have their cameraToObject, so only their animation is updated.
+    if (sObjectCullingPrepassValid && node->header.gfx.node.parent == &gObjParentGraphNode && node->culledByPrepass) {
+        if (node->header.gfx.animInfo.curAnim != NULL) {
+            geo_set_animation_globals(&node->header.gfx.animInfo, (node->header.gfx.node.flags & GRAPH_RENDER_HAS_ANIMATION) != 0);
+        }
+        gCurrAnimType = ANIM_TYPE_NONE;
+        node->header.gfx.throwMatrix = NULL;
+        return;
+    }
+#endif
     if (node->header.gfx.areaIndex == gCurGraphNodeRoot->areaIndex) {
         s32 isInvisible = (node->header.gfx.node.flags & GRAPH_RENDER_INVISIBLE);
+#ifdef ROOM_VISIBILITY_CULLING
+        // Objects in rooms that can't be seen are treated as invisible. Nodes not from the object pool don't have a room.
+        // Objects that got past the pre-pass are already known to be in a visible room, so their room isn't found again.
+        if (!isInvisible && node->header.gfx.node.parent == &gObjParentGraphNode
+#ifdef OBJECT_CULLING_PREPASS
+            && !sObjectCullingPrepassValid
+#endif
+            && !obj_room_is_visible(node)) {
+            isInvisible = TRUE;
+        }
+#endif
         s32 noThrowMatrix = (node->header.gfx.throwMatrix == NULL);
         // Maintain throw matrix pointer if the game is paused as it won't be updated.
         Mat4 *oldThrowMatrix = (sCurrPlayMode == PLAY_MODE_PAUSED) ? node->header.gfx.throwMatrix : NULL;
@@ -1070,7 +1403,7 @@ void geo_process_object(struct Object *node) {
 
         if (!isInvisible && obj_is_in_view(&node->header.gfx)) {
             gMatStackIndex--;
-            inc_mat_stack();
+            inc_mat_stack_cached(node);
 
             if (node->header.gfx.sharedChild != NULL) {
 #ifdef VISUAL_DEBUG
@@ -1100,9 +1433,19 @@ void geo_process_object(struct Object *node) {
  */
 void geo_process_object_parent(struct GraphNodeObjectParent *node) {
     if (node->sharedChild != NULL) {
+#ifdef OBJECT_CULLING_PREPASS
+        // Throw matrices left over from the last frame aren't valid before processing while paused.
+        if (node->sharedChild == &gObjParentGraphNode && sCurrPlayMode != PLAY_MODE_PAUSED) {
+            geo_cull_objects();
+            sObjectCullingPrepassValid = TRUE;
+        }
+#endif
         node->sharedChild->parent = (struct GraphNode *) node;
         geo_process_node_and_siblings(node->sharedChild);
         node->sharedChild->parent = NULL;
+#ifdef OBJECT_CULLING_PREPASS
+        sObjectCullingPrepassValid = FALSE;
+#endif
     }
     if (node->node.children != NULL) {
         geo_process_node_and_siblings(node->node.children);
@@ -1252,6 +1595,9 @@ void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor)
 
         gMatStackIndex = 0;
         gCurrAnimType = ANIM_TYPE_NONE;
+#ifdef ANIMATION_DECODE_CACHE
+        sAnimationDecodeCacheGeneration++;
+#endif
         vec3s_set(viewport->vp.vtrans, node->x * 4, node->y * 4, 511);
         vec3s_set(viewport->vp.vscale, node->width * 4, node->height * 4, 511);
 
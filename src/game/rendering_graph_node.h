@@ -70,5 +70,8 @@ struct RenderModeContainer {
 
 void geo_process_node_and_siblings(struct GraphNode *firstNode);
 void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor);
+#ifdef MATRIX_CACHE
+void alloc_matrix_cache(void);
+#endif
 
 #endif // RENDERING_GRAPH_NODE_H
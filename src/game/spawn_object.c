@@ -1,10 +1,12 @@
 #include <PR/ultratypes.h>
 
 #include "audio/external.h"
+#include "debug.h"
 #include "engine/geo_layout.h"
 #include "engine/graph_node.h"
 #include "engine/math_util.h"
 #include "engine/surface_collision.h"
+#include "engine/surface_load.h"
 #include "level_table.h"
 #include "object_constants.h"
 #include "object_fields.h"
@@ -13,6 +15,105 @@
 #include "spawn_object.h"
 #include "types.h"
 
+/**
+ * The number of distinct behaviors that can be indexed at once. Must be a power of two.
+ * Behaviors that don't fit are left out of the index, and queries for them scan their object list instead.
+ */
+#define BEHAVIOR_INDEX_SIZE 256
+
+/**
+ * An open addressed hash table of the lists of objects with each behavior, cleared with the object lists.
+ */
+static struct BehaviorObjectList sBehaviorIndex[BEHAVIOR_INDEX_SIZE];
+static s32 sNumIndexedBehaviors;
+
+static struct BehaviorObjectList *find_behavior_object_list(const BehaviorScript *behavior, s32 add) {
+    u32 i = ((((uintptr_t) behavior >> 2) * 2654435761U) >> 16);
+
+    while (TRUE) {
+        struct BehaviorObjectList *list = &sBehaviorIndex[i & (BEHAVIOR_INDEX_SIZE - 1)];
+
+        if (list->behavior == behavior) {
+            return list;
+        }
+
+        if (list->behavior == NULL) {
+            // Keep the table at most 3/4 full so probes stay short.
+            if (!add || sNumIndexedBehaviors >= (BEHAVIOR_INDEX_SIZE * 3 / 4)) {
+                return NULL;
+            }
+
+            sNumIndexedBehaviors++;
+            list->behavior = behavior;
+            return list;
+        }
+
+        i++;
+    }
+}
+
+/**
+ * Get the list of objects with the given behavior (virtual address), or NULL if the behavior isn't indexed.
+ * A behavior with no objects loaded may return either an empty list or NULL.
+ */
+struct BehaviorObjectList *get_behavior_object_list(const BehaviorScript *behavior) {
+    return find_behavior_object_list(behavior, FALSE);
+}
+
+void clear_behavior_index(void) {
+    bzero(sBehaviorIndex, sizeof(sBehaviorIndex));
+    sNumIndexedBehaviors = 0;
+}
+
+/**
+ * Append an object to the list of objects with its current behavior.
+ */
+void add_object_to_behavior_index(struct Object *obj) {
+    struct BehaviorObjectList *list = NULL;
+
+    if (obj->objList == get_object_list_from_behavior(obj->behavior)) {
+        list = find_behavior_object_list(obj->behavior, TRUE);
+    }
+
+    obj->behaviorList = list;
+    if (list == NULL) {
+        return;
+    }
+
+    obj->nextWithBehavior = NULL;
+    obj->prevWithBehavior = list->tail;
+    if (list->tail != NULL) {
+        list->tail->nextWithBehavior = obj;
+    } else {
+        list->head = obj;
+    }
+    list->tail = obj;
+}
+
+/**
+ * Remove an object from the list of objects with its behavior, if it's in one.
+ */
+void remove_object_from_behavior_index(struct Object *obj) {
+    struct BehaviorObjectList *list = obj->behaviorList;
+
+    if (list == NULL) {
+        return;
+    }
+
+    if (obj->prevWithBehavior != NULL) {
+        obj->prevWithBehavior->nextWithBehavior = obj->nextWithBehavior;
+    } else {
+        list->head = obj->nextWithBehavior;
+    }
+    if (obj->nextWithBehavior != NULL) {
+        obj->nextWithBehavior->prevWithBehavior = obj->prevWithBehavior;
+    } else {
+        list->tail = obj->prevWithBehavior;
+    }
+
+    obj->behaviorList = NULL;
+}
+
 /**
  * Attempt to allocate an object from freeList (singly linked) and append it
  * to the end of destList (doubly linked). Return the object, or NULL if
@@ -59,7 +160,7 @@ static void deallocate_object(struct ObjectNode *freeList, struct ObjectNode *ob
  */
 void init_free_object_list(void) {
     s32 i;
-    s32 poolLength = OBJECT_POOL_CAPACITY;
+    s32 poolLength = gObjectPoolCapacity;
 
     // Add the first object in the pool to the free list
     struct Object *obj = &gObjectPool[0];
@@ -102,7 +203,14 @@ void unload_object(struct Object *obj) {
 
     obj->header.gfx.node.flags &= ~(GRAPH_RENDER_BILLBOARD | GRAPH_RENDER_ACTIVE);
 
+    remove_object_from_behavior_index(obj);
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    clear_object_dynamic_surfaces(obj);
+#endif
     deallocate_object(&gFreeObjectList, &obj->header);
+#ifdef PUPPYPRINT_DEBUG
+    gObjectPoolStats.used--;
+#endif
 }
 
 /**
@@ -118,12 +226,16 @@ struct Object *allocate_object(struct ObjectNode *objList) {
     // If this happens, we first attempt to unload unimportant objects
     // in order to finish allocating the object.
     if (obj == NULL) {
+#ifdef PUPPYPRINT_DEBUG
+        gObjectPoolStats.allocFailures[objList - gObjectLists]++;
+#endif
         // Look for an unimportant object to kick out.
         struct Object *unimportantObj = find_unimportant_object();
 
         // If no unimportant object exists, then the object pool is exhausted.
         if (unimportantObj == NULL) {
             // We've met with a terrible fate.
+            error("Object pool exhausted");
             while (TRUE) {
             }
         } else {
@@ -139,6 +251,12 @@ struct Object *allocate_object(struct ObjectNode *objList) {
         }
     }
 
+#ifdef PUPPYPRINT_DEBUG
+    if (++gObjectPoolStats.used > gObjectPoolStats.usedHighWater) {
+        gObjectPoolStats.usedHighWater = gObjectPoolStats.used;
+    }
+#endif
+
     // Initialize object fields
 
     obj->activeFlags = ACTIVE_FLAG_ACTIVE | ACTIVE_FLAG_ALLOCATED;
@@ -171,6 +289,7 @@ struct Object *allocate_object(struct ObjectNode *objList) {
 
     obj->platform = NULL;
     obj->collisionData = NULL;
+    obj->behaviorList = NULL;
     obj->oIntangibleTimer = -1;
     obj->oDamageOrCoinValue = 0;
     obj->oHealth = 2048;
@@ -185,6 +304,9 @@ struct Object *allocate_object(struct ObjectNode *objList) {
 
     obj->oDistanceToMario = 19000.0f;
     obj->oRoom = -1;
+#ifdef ROOM_VISIBILITY_CULLING
+    obj->visibilityRoom = 0;
+#endif
 
     obj->header.gfx.node.flags &= ~GRAPH_RENDER_INVISIBLE;
     vec3_same(obj->header.gfx.pos, -10000.0f);
@@ -213,7 +335,12 @@ struct Object *create_object(const BehaviorScript *bhvScript) {
     obj = allocate_object(objList);
 
     obj->curBhvCommand = bhvScript;
+#ifdef DECODED_BEHAVIOR_SCRIPTS
+    obj->curBhvDecoded = NULL;
+#endif
     obj->behavior = bhvScript;
+    obj->objList = objListIndex;
+    add_object_to_behavior_index(obj);
 
     if (objListIndex == OBJ_LIST_UNIMPORTANT) {
         obj->activeFlags |= ACTIVE_FLAG_UNIMPORTANT;
@@ -3,8 +3,23 @@
 
 #include "types.h"
 
+/**
+ * Every loaded object with a given behavior, in the order they were indexed.
+ * Only objects in the object list named by their behavior's BEGIN command are indexed,
+ * since that's the only list the behavior queries search.
+ */
+struct BehaviorObjectList {
+    const BehaviorScript *behavior;
+    struct Object *head;
+    struct Object *tail;
+};
+
 void init_free_object_list(void);
 void clear_object_lists(struct ObjectNode *objLists);
+void clear_behavior_index(void);
+void add_object_to_behavior_index(struct Object *obj);
+void remove_object_from_behavior_index(struct Object *obj);
+struct BehaviorObjectList *get_behavior_object_list(const BehaviorScript *behavior);
 void unload_object(struct Object *obj);
 struct Object *create_object(const BehaviorScript *bhvScript);
 
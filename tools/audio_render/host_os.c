@@ -0,0 +1,156 @@
+#include <ultra64.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "types.h"
+#include "audio/data.h"
+#include "game/emutest.h"
+
+#include "host_os.h"
+
+/**
+ * Stand-ins for the libultra functions and game globals the audio driver uses, so it can run
+ * on a single host thread. PI DMAs copy out of the sound data files, which are loaded into the
+ * arrays the ROM's sound data symbols normally name.
+ */
+
+ALIGNED16 u8 gAudioHeap[DOUBLE_SIZE_ON_64_BIT(AUDIO_HEAP_SIZE)];
+struct Config gConfig = { .audioFrequency = 1.0f };
+enum Emulator gEmulator = EMU_CONSOLE;
+s32 gAudioErrorFlags = 0;
+
+ALIGNED16 u8 gSoundDataADSR[HOST_CTL_DATA_SIZE];
+ALIGNED16 u8 gSoundDataRaw[HOST_TBL_DATA_SIZE];
+ALIGNED16 u8 gMusicData[HOST_SEQUENCE_DATA_SIZE];
+ALIGNED16 u8 gBankSetsData[HOST_BANK_SETS_DATA_SIZE];
+
+u32 gHostDmaCount = 0;
+u32 gHostDmaBytes = 0;
+s32 gHostVerbose = FALSE;
+
+static s32 load_file(const char *dir, const char *name, u8 *dest, size_t maxSize) {
+    char path[1024];
+    FILE *file;
+    size_t size;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Could not open %s\n", path);
+        return FALSE;
+    }
+
+    size = fread(dest, 1, maxSize, file);
+    if (size == maxSize && fgetc(file) != EOF) {
+        fprintf(stderr, "%s is larger than the 0x%zX bytes reserved for it\n", path, maxSize);
+        fclose(file);
+        return FALSE;
+    }
+
+    fclose(file);
+    return TRUE;
+}
+
+/**
+ * Loads the sound data assembled for the host (little endian, 32 bit) from a directory.
+ */
+s32 host_os_load_sound_data(const char *dir) {
+    return load_file(dir, "sound_data.ctl", gSoundDataADSR, sizeof(gSoundDataADSR))
+        && load_file(dir, "sound_data.tbl", gSoundDataRaw, sizeof(gSoundDataRaw))
+        && load_file(dir, "sequences.bin", gMusicData, sizeof(gMusicData))
+        && load_file(dir, "bank_sets", gBankSetsData, sizeof(gBankSetsData));
+}
+
+void host_os_reset_dma_stats(void) {
+    gHostDmaCount = 0;
+    gHostDmaBytes = 0;
+}
+
+void osCreateMesgQueue(OSMesgQueue *mq, OSMesg *msg, s32 count) {
+    mq->mtqueue = NULL;
+    mq->fullqueue = NULL;
+    mq->validCount = 0;
+    mq->first = 0;
+    mq->msgCount = count;
+    mq->msg = msg;
+}
+
+s32 osSendMesg(OSMesgQueue *mq, OSMesg msg, UNUSED s32 flag) {
+    // With a single thread, nothing could ever empty a full queue, so blocking sends fail too.
+    if (mq->validCount >= mq->msgCount) {
+        return -1;
+    }
+
+    mq->msg[(mq->first + mq->validCount) % mq->msgCount] = msg;
+    mq->validCount++;
+    return 0;
+}
+
+s32 osRecvMesg(OSMesgQueue *mq, OSMesg *msg, s32 flag) {
+    if (mq->validCount == 0) {
+        if (flag == OS_MESG_BLOCK) {
+            fprintf(stderr, "osRecvMesg: blocking on an empty queue would never return\n");
+            exit(1);
+        }
+        return -1;
+    }
+
+    if (msg != NULL) {
+        *msg = mq->msg[mq->first];
+    }
+    mq->first = (mq->first + 1) % mq->msgCount;
+    mq->validCount--;
+    return 0;
+}
+
+/**
+ * DMAs complete immediately, so the message is already waiting by the time the driver checks for it.
+ */
+s32 osPiStartDma(OSIoMesg *mb, UNUSED s32 priority, UNUSED s32 direction, u32 devAddr, void *vAddr, u32 nbytes, OSMesgQueue *mq) {
+    memcpy(vAddr, (void *)(uintptr_t) devAddr, nbytes);
+    gHostDmaCount++;
+    gHostDmaBytes += nbytes;
+
+    if (mq != NULL) {
+        osSendMesg(mq, (OSMesg) mb, OS_MESG_NOBLOCK);
+    }
+    return 0;
+}
+
+void osInvalDCache(UNUSED void *vaddr, UNUSED s32 nbytes) {
+}
+
+void osWritebackDCache(UNUSED void *vaddr, UNUSED s32 nbytes) {
+}
+
+void osWritebackDCacheAll(void) {
+}
+
+/**
+ * Returns the frequency the AI would really run at, which is what the driver sizes its buffers from.
+ */
+s32 osAiSetFrequency(u32 frequency) {
+    u32 dacRate = ((2 * VI_NTSC_CLOCK / frequency) + 1) / 2;
+
+    return VI_NTSC_CLOCK / dacRate;
+}
+
+void osSyncPrintf(const char *fmt, ...) {
+    va_list args;
+
+    if (gHostVerbose) {
+        va_start(args, fmt);
+        vfprintf(stderr, fmt, args);
+        va_end(args);
+    }
+}
+
+void alSeqFileNew(ALSeqFile *file, u8 *base) {
+    s32 i;
+
+    for (i = 0; i < file->seqCount; i++) {
+        file->seqArray[i].offset = base + (uintptr_t) file->seqArray[i].offset;
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef HOST_OS_H
+#define HOST_OS_H
+
+#include <ultra64.h>
+
+/**
+ * The largest sound data files the renderer can load, in bytes.
+ */
+#define HOST_CTL_DATA_SIZE       0x200000
+#define HOST_TBL_DATA_SIZE       0x2000000
+#define HOST_SEQUENCE_DATA_SIZE  0x200000
+#define HOST_BANK_SETS_DATA_SIZE 0x10000
+
+// PI DMAs requested by the audio driver since the last call to host_os_reset_dma_stats.
+extern u32 gHostDmaCount;
+extern u32 gHostDmaBytes;
+
+extern s32 gHostVerbose;
+
+s32 host_os_load_sound_data(const char *dir);
+void host_os_reset_dma_stats(void);
+
+#endif // HOST_OS_H
@@ -0,0 +1,277 @@
+/**
+ * audio_render: renders a sequence to a WAV file on the host.
+ *
+ * The game's sequencer, note playback and synthesis code (src/audio) runs unchanged, and the audio
+ * command list it builds every frame is run by rsp_audio.c instead of the RSP. Sound data is read
+ * from files instead of the ROM, so it has to be assembled for the host first; `make audio-render`
+ * does both, and puts the sound data in build/<version>/host_sound.
+ *
+ * Usage: audio_render [options] <sequence id>
+ *   -d <dir>      Sound data directory (default: build/us/host_sound)
+ *   -o <file>     WAV file to write (default: none, only render)
+ *   -s <seconds>  Length to render, if the sequence doesn't end first (default: 30)
+ *   -e            Use the emulator note limit instead of the console one
+ *   -b            Print how long the CPU and the command list took to render
+ *   -v            Print the audio driver's debug output
+ *
+ * Rendering is deterministic, so the WAV of a sequence only changes when the audio code or its data does.
+ */
+
+#include <ultra64.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "audio/data.h"
+#include "audio/external.h"
+#include "audio/load.h"
+#include "audio/synthesis.h"
+#include "game/emutest.h"
+#include "seq_ids.h"
+
+#include "host_os.h"
+#include "rsp_audio.h"
+
+#if !defined(VERSION_JP) && !defined(VERSION_US)
+#error "The audio renderer only supports the JP and US audio driver."
+#endif
+
+// Frames rendered after the sequence ends, so that releasing notes and reverb can fade out.
+#define TAIL_FRAMES 60
+
+extern s32 gMaxAudioCmds;
+
+struct RenderStats {
+    f64 cpuSeconds;
+    f64 rspSeconds;
+    u32 frames;
+    u32 samples;
+    u32 commands;
+    u32 maxCommands;
+    u32 maxNotes;
+    u32 dmaCount;
+    u32 dmaBytes;
+};
+
+static f64 get_time(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void write_u16(FILE *file, u32 value) {
+    fputc(value & 0xFF, file);
+    fputc((value >> 8) & 0xFF, file);
+}
+
+static void write_u32(FILE *file, u32 value) {
+    write_u16(file, value & 0xFFFF);
+    write_u16(file, value >> 16);
+}
+
+/**
+ * Writes the header of a 16 bit stereo WAV file. Called again once the length is known.
+ */
+static void write_wav_header(FILE *file, u32 sampleRate, u32 numSamples) {
+    u32 dataSize = numSamples * 2 * sizeof(s16);
+
+    fseek(file, 0, SEEK_SET);
+    fwrite("RIFF", 1, 4, file);
+    write_u32(file, 36 + dataSize);
+    fwrite("WAVEfmt ", 1, 8, file);
+    write_u32(file, 16);
+    write_u16(file, 1); // PCM
+    write_u16(file, 2); // Channels
+    write_u32(file, sampleRate);
+    write_u32(file, sampleRate * 2 * sizeof(s16));
+    write_u16(file, 2 * sizeof(s16));
+    write_u16(file, 16);
+    fwrite("data", 1, 4, file);
+    write_u32(file, dataSize);
+}
+
+static void write_wav_samples(FILE *file, s16 *samples, s32 count) {
+    s32 i;
+
+    for (i = 0; i < count; i++) {
+        write_u16(file, (u16) samples[i]);
+    }
+}
+
+/**
+ * Renders one frame of audio, like create_next_audio_frame_task followed by the RSP running the task.
+ * Returns the number of stereo samples written to the current AI buffer.
+ */
+static s32 render_frame(struct RenderStats *stats) {
+    static s32 samplesOwed = 0;
+    s32 writtenCmds;
+    s32 numNotes = 0;
+    s32 bufLen;
+    s16 *aiBuf;
+    f64 start;
+    s32 i;
+
+    gAudioFrameCount++;
+    gAudioTaskIndex ^= 1;
+    gCurrAiBufferIndex = (gCurrAiBufferIndex + 1) % NUMAIBUFFERS;
+    gCurrAudioFrameDmaCount = 0;
+    gAudioCmd = gAudioCmdBuffers[gAudioTaskIndex];
+    aiBuf = gAiBuffers[gCurrAiBufferIndex];
+
+    // The AI plays gAiFrequency / 60 samples a frame. Render exactly that on average,
+    // in the multiples of 16 samples the driver works in.
+    samplesOwed += gAiFrequency;
+    bufLen = ALIGN16(samplesOwed / 60);
+    if (bufLen < gMinAiBufferLength) {
+        bufLen = gMinAiBufferLength;
+    }
+    if (bufLen > gSamplesPerFrameTarget + 0x10) {
+        bufLen = gSamplesPerFrameTarget + 0x10;
+    }
+    samplesOwed -= bufLen * 60;
+    gAiBufferLengths[gCurrAiBufferIndex] = bufLen;
+
+    start = get_time();
+    synthesis_execute(gAudioCmd, &writtenCmds, aiBuf, bufLen);
+    gAudioRandom = ((gAudioRandom + gAudioFrameCount) * gAudioFrameCount);
+    stats->cpuSeconds += get_time() - start;
+
+    if (writtenCmds > gMaxAudioCmds) {
+        // The commands past the end have already overwritten whatever follows the buffer.
+        fprintf(stderr, "Frame %u: %d audio commands overflowed the %d command buffer\n", stats->frames, writtenCmds, gMaxAudioCmds);
+        exit(1);
+    }
+
+    start = get_time();
+    if (rsp_audio_run((Acmd *) gAudioCmd, writtenCmds) < 0) {
+        exit(1);
+    }
+    stats->rspSeconds += get_time() - start;
+
+    decrease_sample_dma_ttls();
+
+    for (i = 0; i < gMaxSimultaneousNotes; i++) {
+        if (gNotes[i].enabled) {
+            numNotes++;
+        }
+    }
+
+    stats->frames++;
+    stats->samples += bufLen;
+    stats->commands += writtenCmds;
+    stats->maxCommands = MAX(stats->maxCommands, (u32) writtenCmds);
+    stats->maxNotes = MAX(stats->maxNotes, (u32) numNotes);
+    return bufLen;
+}
+
+static void print_usage(const char *name) {
+    fprintf(stderr, "Usage: %s [-d <sound data dir>] [-o <out.wav>] [-s <seconds>] [-e] [-b] [-v] <sequence id>\n", name);
+}
+
+int main(int argc, char **argv) {
+    const char *soundDir = "build/us/host_sound";
+    const char *outPath = NULL;
+    s32 benchmark = FALSE;
+    f64 seconds = 30.0;
+    s32 seqId = -1;
+    struct RenderStats stats;
+    FILE *outFile = NULL;
+    u32 maxSamples;
+    s32 tailFrames = TAIL_FRAMES;
+    f64 start;
+    s32 i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            soundDir = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-e") == 0) {
+            gEmulator = EMU_PARALLELN64;
+        } else if (strcmp(argv[i], "-b") == 0) {
+            benchmark = TRUE;
+        } else if (strcmp(argv[i], "-v") == 0) {
+            gHostVerbose = TRUE;
+        } else if (argv[i][0] != '-' && seqId < 0) {
+            seqId = strtol(argv[i], NULL, 0);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (seqId < 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (!host_os_load_sound_data(soundDir)) {
+        return 1;
+    }
+
+    audio_init();
+
+    if ((seqId & SEQ_BASE_ID) >= gSeqFileHeader->seqCount) {
+        fprintf(stderr, "Sequence 0x%02X doesn't exist, there are %d sequences\n", seqId, gSeqFileHeader->seqCount);
+        return 1;
+    }
+
+    gSequencePlayers[SEQ_PLAYER_LEVEL].seqVariation = seqId & SEQ_VARIATION;
+    load_sequence(SEQ_PLAYER_LEVEL, seqId & SEQ_BASE_ID, FALSE);
+    if (!gSequencePlayers[SEQ_PLAYER_LEVEL].enabled) {
+        fprintf(stderr, "Sequence 0x%02X failed to load\n", seqId);
+        return 1;
+    }
+
+    if (outPath != NULL) {
+        outFile = fopen(outPath, "wb");
+        if (outFile == NULL) {
+            fprintf(stderr, "Could not open %s\n", outPath);
+            return 1;
+        }
+        write_wav_header(outFile, gAiFrequency, 0);
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    host_os_reset_dma_stats();
+    maxSamples = (u32)(seconds * gAiFrequency);
+    start = get_time();
+
+    while (stats.samples < maxSamples && tailFrames > 0) {
+        s32 bufLen = render_frame(&stats);
+
+        if (outFile != NULL) {
+            write_wav_samples(outFile, gAiBuffers[gCurrAiBufferIndex], bufLen * 2);
+        }
+        if (!gSequencePlayers[SEQ_PLAYER_LEVEL].enabled) {
+            tailFrames--;
+        }
+    }
+
+    stats.dmaCount = gHostDmaCount;
+    stats.dmaBytes = gHostDmaBytes;
+
+    if (outFile != NULL) {
+        write_wav_header(outFile, gAiFrequency, stats.samples);
+        fclose(outFile);
+    }
+
+    if (benchmark) {
+        f64 audioSeconds = (f64) stats.samples / gAiFrequency;
+        f64 totalSeconds = get_time() - start;
+
+        printf("Sequence 0x%02X: %u frames, %.2f s of audio at %d Hz\n", seqId, stats.frames, audioSeconds, gAiFrequency);
+        printf("  Sequences and synthesis: %8.3f ms (%.2f us/frame)\n", stats.cpuSeconds * 1e3, stats.cpuSeconds * 1e6 / stats.frames);
+        printf("  Audio command list:      %8.3f ms (%.2f us/frame)\n", stats.rspSeconds * 1e3, stats.rspSeconds * 1e6 / stats.frames);
+        printf("  Commands:   %.1f/frame, %u max (buffer holds %d)\n", (f64) stats.commands / stats.frames, stats.maxCommands, gMaxAudioCmds);
+        printf("  Notes:      %u max of %d\n", stats.maxNotes, gMaxSimultaneousNotes);
+        printf("  DMAs:       %u, %u bytes\n", stats.dmaCount, stats.dmaBytes);
+        printf("  Realtime:   %.1fx\n", audioSeconds / totalSeconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,414 @@
+#include <ultra64.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rsp_audio.h"
+
+/**
+ * A C implementation of the audio microcode's command set (the JP/US ABI in PR/abi.h).
+ * Each command follows the fixed point arithmetic of its rsp/audio.s counterpart, so the sequencer
+ * and synthesis code can be run and measured without an emulator.
+ */
+
+#define ROUND_UP_8(v)  (((v) + 7) & ~7)
+#define ROUND_UP_16(v) (((v) + 15) & ~15)
+#define ROUND_UP_32(v) (((v) + 31) & ~31)
+
+#define DMEM_SIZE 0x1000
+
+static struct {
+    // Set by aSetBuffer
+    u16 in;
+    u16 out;
+    u16 nbytes;
+    u16 dryRight;
+    u16 wetLeft;
+    u16 wetRight;
+
+    // Set by aSetVolume
+    s16 vol[2];
+    s16 target[2];
+    s32 rate[2];
+    s16 volDry;
+    s16 volWet;
+
+    s16 *adpcmLoopState;
+    s16 adpcmTable[16][2][8];
+
+    union {
+        s16 as_s16[DMEM_SIZE / sizeof(s16)];
+        u8 as_u8[DMEM_SIZE];
+    } dmem;
+} sRspAudio;
+
+// The resampling filter, copied from the data section of rsp/audio.s.
+static const s16 sResampleTable[64][4] = {
+    { 0x0c39, 0x66ad, 0x0d46, 0xffdf }, { 0x0b39, 0x6696, 0x0e5f, 0xffd8 },
+    { 0x0a44, 0x6669, 0x0f83, 0xffd0 }, { 0x095a, 0x6626, 0x10b4, 0xffc8 },
+    { 0x087d, 0x65cd, 0x11f0, 0xffbf }, { 0x07ab, 0x655e, 0x1338, 0xffb6 },
+    { 0x06e4, 0x64d9, 0x148c, 0xffac }, { 0x0628, 0x643f, 0x15eb, 0xffa1 },
+    { 0x0577, 0x638f, 0x1756, 0xff96 }, { 0x04d1, 0x62cb, 0x18cb, 0xff8a },
+    { 0x0435, 0x61f3, 0x1a4c, 0xff7e }, { 0x03a4, 0x6106, 0x1bd7, 0xff71 },
+    { 0x031c, 0x6007, 0x1d6c, 0xff64 }, { 0x029f, 0x5ef5, 0x1f0b, 0xff56 },
+    { 0x022a, 0x5dd0, 0x20b3, 0xff48 }, { 0x01be, 0x5c9a, 0x2264, 0xff3a },
+    { 0x015b, 0x5b53, 0x241e, 0xff2c }, { 0x0101, 0x59fc, 0x25e0, 0xff1e },
+    { 0x00ae, 0x5896, 0x27a9, 0xff10 }, { 0x0063, 0x5720, 0x297a, 0xff02 },
+    { 0x001f, 0x559d, 0x2b50, 0xfef4 }, { 0xffe2, 0x540d, 0x2d2c, 0xfee8 },
+    { 0xffac, 0x5270, 0x2f0d, 0xfedb }, { 0xff7c, 0x50c7, 0x30f3, 0xfed0 },
+    { 0xff53, 0x4f14, 0x32dc, 0xfec6 }, { 0xff2e, 0x4d57, 0x34c8, 0xfebd },
+    { 0xff0f, 0x4b91, 0x36b6, 0xfeb6 }, { 0xfef5, 0x49c2, 0x38a5, 0xfeb0 },
+    { 0xfedf, 0x47ed, 0x3a95, 0xfeac }, { 0xfece, 0x4611, 0x3c85, 0xfeab },
+    { 0xfec0, 0x4430, 0x3e74, 0xfeac }, { 0xfeb6, 0x424a, 0x4060, 0xfeaf },
+    { 0xfeaf, 0x4060, 0x424a, 0xfeb6 }, { 0xfeac, 0x3e74, 0x4430, 0xfec0 },
+    { 0xfeab, 0x3c85, 0x4611, 0xfece }, { 0xfeac, 0x3a95, 0x47ed, 0xfedf },
+    { 0xfeb0, 0x38a5, 0x49c2, 0xfef5 }, { 0xfeb6, 0x36b6, 0x4b91, 0xff0f },
+    { 0xfebd, 0x34c8, 0x4d57, 0xff2e }, { 0xfec6, 0x32dc, 0x4f14, 0xff53 },
+    { 0xfed0, 0x30f3, 0x50c7, 0xff7c }, { 0xfedb, 0x2f0d, 0x5270, 0xffac },
+    { 0xfee8, 0x2d2c, 0x540d, 0xffe2 }, { 0xfef4, 0x2b50, 0x559d, 0x001f },
+    { 0xff02, 0x297a, 0x5720, 0x0063 }, { 0xff10, 0x27a9, 0x5896, 0x00ae },
+    { 0xff1e, 0x25e0, 0x59fc, 0x0101 }, { 0xff2c, 0x241e, 0x5b53, 0x015b },
+    { 0xff3a, 0x2264, 0x5c9a, 0x01be }, { 0xff48, 0x20b3, 0x5dd0, 0x022a },
+    { 0xff56, 0x1f0b, 0x5ef5, 0x029f }, { 0xff64, 0x1d6c, 0x6007, 0x031c },
+    { 0xff71, 0x1bd7, 0x6106, 0x03a4 }, { 0xff7e, 0x1a4c, 0x61f3, 0x0435 },
+    { 0xff8a, 0x18cb, 0x62cb, 0x04d1 }, { 0xff96, 0x1756, 0x638f, 0x0577 },
+    { 0xffa1, 0x15eb, 0x643f, 0x0628 }, { 0xffac, 0x148c, 0x64d9, 0x06e4 },
+    { 0xffb6, 0x1338, 0x655e, 0x07ab }, { 0xffbf, 0x11f0, 0x65cd, 0x087d },
+    { 0xffc8, 0x10b4, 0x6626, 0x095a }, { 0xffd0, 0x0f83, 0x6669, 0x0a44 },
+    { 0xffd8, 0x0e5f, 0x6696, 0x0b39 }, { 0xffdf, 0x0d46, 0x66ad, 0x0c39 },
+};
+
+static s16 clamp16(s32 v) {
+    if (v < -0x8000) {
+        return -0x8000;
+    } else if (v > 0x7FFF) {
+        return 0x7FFF;
+    }
+    return (s16) v;
+}
+
+static s32 clamp32(s64 v) {
+    if (v < -0x7FFFFFFF - 1) {
+        return -0x7FFFFFFF - 1;
+    } else if (v > 0x7FFFFFFF) {
+        return 0x7FFFFFFF;
+    }
+    return (s32) v;
+}
+
+/**
+ * Returns a pointer into DMEM, stopping the render if a command reaches outside of it,
+ * which on the RSP would silently wrap around and corrupt the microcode's own data.
+ */
+static void *dmem_ptr(u32 addr, u32 nbytes) {
+    if (addr + nbytes > DMEM_SIZE) {
+        fprintf(stderr, "rsp_audio: DMEM access out of range (0x%X, 0x%X bytes)\n", addr, nbytes);
+        exit(1);
+    }
+    return &sRspAudio.dmem.as_u8[addr];
+}
+
+static void rsp_audio_clear_buffer(u16 addr, s32 nbytes) {
+    nbytes = ROUND_UP_16(nbytes);
+    memset(dmem_ptr(addr, nbytes), 0, nbytes);
+}
+
+static void rsp_audio_load_buffer(const void *src) {
+    s32 nbytes = ROUND_UP_8(sRspAudio.nbytes);
+    memcpy(dmem_ptr(sRspAudio.in, nbytes), src, nbytes);
+}
+
+static void rsp_audio_save_buffer(void *dest) {
+    s32 nbytes = ROUND_UP_8(sRspAudio.nbytes);
+    memcpy(dest, dmem_ptr(sRspAudio.out, nbytes), nbytes);
+}
+
+static void rsp_audio_set_buffer(u8 flags, u16 in, u16 out, u16 nbytes) {
+    if (flags & A_AUX) {
+        sRspAudio.dryRight = in;
+        sRspAudio.wetLeft = out;
+        sRspAudio.wetRight = nbytes;
+    } else {
+        sRspAudio.in = in;
+        sRspAudio.out = out;
+        sRspAudio.nbytes = nbytes;
+    }
+}
+
+static void rsp_audio_set_volume(u8 flags, s16 vol, u32 w1) {
+    s32 channel = (flags & A_LEFT) ? 0 : 1;
+
+    if (flags & A_AUX) {
+        sRspAudio.volDry = vol;
+        sRspAudio.volWet = (s16) w1;
+    } else if (flags & A_VOL) {
+        sRspAudio.vol[channel] = vol;
+    } else {
+        sRspAudio.target[channel] = vol;
+        sRspAudio.rate[channel] = (s32) w1;
+    }
+}
+
+static void rsp_audio_dmem_move(u16 in, u16 out, s32 nbytes) {
+    nbytes = ROUND_UP_16(nbytes);
+    memmove(dmem_ptr(out, nbytes), dmem_ptr(in, nbytes), nbytes);
+}
+
+static void rsp_audio_interleave(u16 left, u16 right) {
+    s32 count = ROUND_UP_16(sRspAudio.nbytes) / sizeof(s16);
+    s16 *l = dmem_ptr(left, count * sizeof(s16));
+    s16 *r = dmem_ptr(right, count * sizeof(s16));
+    s16 *out = dmem_ptr(sRspAudio.out, count * 2 * sizeof(s16));
+    s16 interleaved[DMEM_SIZE / sizeof(s16)];
+    s32 i;
+
+    // The output may overlap the inputs, so build it separately first.
+    for (i = 0; i < count; i++) {
+        interleaved[i * 2 + 0] = l[i];
+        interleaved[i * 2 + 1] = r[i];
+    }
+    memcpy(out, interleaved, count * 2 * sizeof(s16));
+}
+
+static void rsp_audio_adpcm_decode(u8 flags, s16 *state) {
+    s32 nbytes = ROUND_UP_32(sRspAudio.nbytes);
+    u8 *in = dmem_ptr(sRspAudio.in, nbytes / 32 * 9);
+    s16 *out = dmem_ptr(sRspAudio.out, (16 + nbytes / sizeof(s16)) * sizeof(s16));
+    s32 i, j, k;
+
+    if (flags & A_INIT) {
+        memset(out, 0, 16 * sizeof(s16));
+    } else if (flags & A_LOOP) {
+        memcpy(out, sRspAudio.adpcmLoopState, 16 * sizeof(s16));
+    } else {
+        memcpy(out, state, 16 * sizeof(s16));
+    }
+    out += 16;
+
+    while (nbytes > 0) {
+        s32 shift = *in >> 4;
+        s16 (*book)[8] = sRspAudio.adpcmTable[*in++ & 0xF];
+
+        for (i = 0; i < 2; i++) {
+            s16 ins[8];
+            s16 prev1 = out[-1];
+            s16 prev2 = out[-2];
+
+            for (j = 0; j < 4; j++) {
+                ins[j * 2 + 0] = ((s32)((u32)(*in >> 4) << 28) >> 28) << shift;
+                ins[j * 2 + 1] = ((s32)((u32)(*in++ & 0xF) << 28) >> 28) << shift;
+            }
+            for (j = 0; j < 8; j++) {
+                s32 acc = book[0][j] * prev2 + book[1][j] * prev1 + (ins[j] << 11);
+                for (k = 0; k < j; k++) {
+                    acc += book[1][j - k - 1] * ins[k];
+                }
+                *out++ = clamp16(acc >> 11);
+            }
+        }
+        nbytes -= 16 * sizeof(s16);
+    }
+
+    memcpy(state, out - 16, 16 * sizeof(s16));
+}
+
+static void rsp_audio_resample(u8 flags, u16 pitch, s16 *state) {
+    s32 nbytes = ROUND_UP_16(sRspAudio.nbytes);
+    s16 *inStart = dmem_ptr(sRspAudio.in, nbytes);
+    s16 *in = inStart;
+    s16 *out = dmem_ptr(sRspAudio.out, nbytes);
+    s16 tmp[16];
+    u32 pitchAccumulator;
+    s32 i;
+
+    if (flags & A_INIT) {
+        memset(tmp, 0, 5 * sizeof(s16));
+    } else {
+        memcpy(tmp, state, 16 * sizeof(s16));
+    }
+    if (flags & A_OUT) {
+        memcpy(in - 8, tmp + 8, 8 * sizeof(s16));
+        in -= tmp[5] / (s32) sizeof(s16);
+    }
+    in -= 4;
+    pitchAccumulator = (u16) tmp[4];
+    memcpy(in, tmp, 4 * sizeof(s16));
+
+    do {
+        for (i = 0; i < 8; i++) {
+            const s16 *filter = sResampleTable[pitchAccumulator * 64 >> 16];
+            s32 sample = ((in[0] * filter[0] + 0x4000) >> 15)
+                       + ((in[1] * filter[1] + 0x4000) >> 15)
+                       + ((in[2] * filter[2] + 0x4000) >> 15)
+                       + ((in[3] * filter[3] + 0x4000) >> 15);
+            *out++ = clamp16(sample);
+
+            pitchAccumulator += (pitch << 1);
+            in += pitchAccumulator >> 16;
+            pitchAccumulator &= 0xFFFF;
+        }
+        nbytes -= 8 * sizeof(s16);
+    } while (nbytes > 0);
+
+    state[4] = (s16) pitchAccumulator;
+    memcpy(state, in, 4 * sizeof(s16));
+    i = (in - inStart + 4) & 7;
+    in -= i;
+    if (i != 0) {
+        i = -8 - i;
+    }
+    state[5] = i;
+    memcpy(state + 8, in, 8 * sizeof(s16));
+}
+
+static void rsp_audio_env_mixer(u8 flags, s16 *state) {
+    s32 nbytes = ROUND_UP_16(sRspAudio.nbytes);
+    s16 *in = dmem_ptr(sRspAudio.in, nbytes);
+    s16 *dry[2] = { dmem_ptr(sRspAudio.out, nbytes), dmem_ptr(sRspAudio.dryRight, nbytes) };
+    s16 *wet[2] = { dmem_ptr(sRspAudio.wetLeft, nbytes), dmem_ptr(sRspAudio.wetRight, nbytes) };
+    s16 target[2];
+    s32 rate[2];
+    s16 volDry, volWet;
+    s32 vols[2][8];
+    s32 c, i;
+
+    if (flags & A_INIT) {
+        for (c = 0; c < 2; c++) {
+            s32 stepDiff;
+
+            target[c] = sRspAudio.target[c];
+            rate[c] = sRspAudio.rate[c];
+            stepDiff = sRspAudio.vol[c] * (rate[c] - 0x10000) / 8;
+            for (i = 0; i < 8; i++) {
+                vols[c][i] = clamp32(((s64) sRspAudio.vol[c] << 16) + stepDiff * (i + 1));
+            }
+        }
+        volDry = sRspAudio.volDry;
+        volWet = sRspAudio.volWet;
+    } else {
+        memcpy(vols[0], state, 8 * sizeof(s32));
+        memcpy(vols[1], state + 16, 8 * sizeof(s32));
+        target[0] = state[32];
+        target[1] = state[35];
+        rate[0] = (state[33] << 16) | (u16) state[34];
+        rate[1] = (state[36] << 16) | (u16) state[37];
+        volDry = state[38];
+        volWet = state[39];
+    }
+
+    do {
+        for (c = 0; c < 2; c++) {
+            for (i = 0; i < 8; i++) {
+                if ((rate[c] >> 16) > 0) {
+                    // Increasing volume
+                    if ((vols[c][i] >> 16) > target[c]) {
+                        vols[c][i] = target[c] << 16;
+                    }
+                } else {
+                    // Decreasing volume
+                    if ((vols[c][i] >> 16) < target[c]) {
+                        vols[c][i] = target[c] << 16;
+                    }
+                }
+                dry[c][i] = clamp16((dry[c][i] * 0x7FFF + in[i] * (((vols[c][i] >> 16) * volDry + 0x4000) >> 15) + 0x4000) >> 15);
+                if (flags & A_AUX) {
+                    wet[c][i] = clamp16((wet[c][i] * 0x7FFF + in[i] * (((vols[c][i] >> 16) * volWet + 0x4000) >> 15) + 0x4000) >> 15);
+                }
+                vols[c][i] = clamp32((s64) vols[c][i] * rate[c] >> 16);
+            }
+            dry[c] += 8;
+            wet[c] += 8;
+        }
+        in += 8;
+        nbytes -= 8 * sizeof(s16);
+    } while (nbytes > 0);
+
+    memcpy(state, vols[0], 8 * sizeof(s32));
+    memcpy(state + 16, vols[1], 8 * sizeof(s32));
+    state[32] = target[0];
+    state[33] = (s16)(rate[0] >> 16);
+    state[34] = (s16) rate[0];
+    state[35] = target[1];
+    state[36] = (s16)(rate[1] >> 16);
+    state[37] = (s16) rate[1];
+    state[38] = volDry;
+    state[39] = volWet;
+}
+
+static void rsp_audio_mix(s16 gain, u16 inAddr, u16 outAddr) {
+    s32 nbytes = ROUND_UP_32(sRspAudio.nbytes);
+    s16 *in = dmem_ptr(inAddr, nbytes);
+    s16 *out = dmem_ptr(outAddr, nbytes);
+    s32 i;
+
+    for (i = 0; i < nbytes / (s32) sizeof(s16); i++) {
+        // A gain of -100% is a plain subtraction on the RSP, without the usual rounding.
+        if (gain == -0x8000) {
+            out[i] = clamp16(out[i] - in[i]);
+        } else {
+            out[i] = clamp16((out[i] * 0x7FFF + in[i] * gain + 0x4000) >> 15);
+        }
+    }
+}
+
+s32 rsp_audio_run(Acmd *cmds, s32 numCmds) {
+    s32 i;
+
+    for (i = 0; i < numCmds; i++) {
+        u32 w0 = cmds[i].words.w0;
+        u32 w1 = cmds[i].words.w1;
+        u8 flags = (w0 >> 16) & 0xFF;
+
+        switch (w0 >> 24) {
+            case A_SPNOOP:
+            case A_SEGMENT:
+                // Addresses are already physical, so the segment table is never read.
+                break;
+            case A_ADPCM:
+                rsp_audio_adpcm_decode(flags, (s16 *)(uintptr_t) w1);
+                break;
+            case A_CLEARBUFF:
+                rsp_audio_clear_buffer(w0 & 0xFFFF, w1 & 0xFFFF);
+                break;
+            case A_ENVMIXER:
+                rsp_audio_env_mixer(flags, (s16 *)(uintptr_t) w1);
+                break;
+            case A_LOADBUFF:
+                rsp_audio_load_buffer((void *)(uintptr_t) w1);
+                break;
+            case A_RESAMPLE:
+                rsp_audio_resample(flags, w0 & 0xFFFF, (s16 *)(uintptr_t) w1);
+                break;
+            case A_SAVEBUFF:
+                rsp_audio_save_buffer((void *)(uintptr_t) w1);
+                break;
+            case A_SETBUFF:
+                rsp_audio_set_buffer(flags, w0 & 0xFFFF, w1 >> 16, w1 & 0xFFFF);
+                break;
+            case A_SETVOL:
+                rsp_audio_set_volume(flags, w0 & 0xFFFF, w1);
+                break;
+            case A_DMEMMOVE:
+                rsp_audio_dmem_move(w0 & 0xFFFF, w1 >> 16, w1 & 0xFFFF);
+                break;
+            case A_LOADADPCM:
+                memcpy(sRspAudio.adpcmTable, (void *)(uintptr_t) w1,
+                       ((w0 & 0xFFFF) < sizeof(sRspAudio.adpcmTable)) ? (w0 & 0xFFFF) : sizeof(sRspAudio.adpcmTable));
+                break;
+            case A_MIXER:
+                rsp_audio_mix(w0 & 0xFFFF, w1 >> 16, w1 & 0xFFFF);
+                break;
+            case A_INTERLEAVE:
+                rsp_audio_interleave(w1 >> 16, w1 & 0xFFFF);
+                break;
+            case A_SETLOOP:
+                sRspAudio.adpcmLoopState = (s16 *)(uintptr_t) w1;
+                break;
+            default:
+                fprintf(stderr, "rsp_audio: unsupported audio command 0x%02X\n", w0 >> 24);
+                return -1;
+        }
+    }
+
+    return i;
+}
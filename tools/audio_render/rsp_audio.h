@@ -0,0 +1,13 @@
+#ifndef RSP_AUDIO_H
+#define RSP_AUDIO_H
+
+#include <ultra64.h>
+
+/**
+ * Runs an audio command list on the CPU, the way the audio microcode (rsp/audio.s) runs it on the RSP.
+ * DRAM addresses in the commands are host pointers, since the renderer is built with NO_SEGMENTED_MEMORY.
+ * Returns the number of commands run, or -1 if the list contained a command the microcode doesn't have.
+ */
+s32 rsp_audio_run(Acmd *cmds, s32 numCmds);
+
+#endif // RSP_AUDIO_H
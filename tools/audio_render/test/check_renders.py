@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""
+Renders each sequence listed in render_hashes.txt with audio_render, and compares the SHA-1 of the
+WAV against the recorded one. With --update, records the current hashes in the file instead.
+
+Usage: check_renders.py <audio_render> <sound data dir> <render_hashes.txt> [--update]
+"""
+import sys
+import hashlib
+import argparse
+import subprocess
+import tempfile
+import os
+
+def read_entries(path):
+    entries = []
+    lines = open(path).read().splitlines()
+    for i, line in enumerate(lines):
+        fields = line.split("#", 1)[0].split()
+        if not fields:
+            continue
+        if len(fields) != 3:
+            sys.exit("error: %s:%d: expected <sequence id> <seconds> <sha1>" % (path, i + 1))
+        entries.append((i, fields[0], fields[1], fields[2]))
+    return lines, entries
+
+def render(tool, soundDir, seqId, seconds, wavPath):
+    result = subprocess.run([tool, "-d", soundDir, "-s", seconds, "-o", wavPath, seqId])
+    if result.returncode != 0:
+        sys.exit("error: rendering sequence %s failed" % seqId)
+    with open(wavPath, "rb") as f:
+        return hashlib.sha1(f.read()).hexdigest()
+
+def main():
+    parser = argparse.ArgumentParser(description="Check audio_render output against recorded hashes.")
+    parser.add_argument("tool")
+    parser.add_argument("sound_dir")
+    parser.add_argument("hashes")
+    parser.add_argument("--update", action="store_true", help="record the current hashes instead of checking them")
+    args = parser.parse_args()
+
+    lines, entries = read_entries(args.hashes)
+    failed = 0
+    unrecorded = 0
+
+    with tempfile.TemporaryDirectory() as tmp:
+        wavPath = os.path.join(tmp, "render.wav")
+        for lineIndex, seqId, seconds, expected in entries:
+            actual = render(args.tool, args.sound_dir, seqId, seconds, wavPath)
+            if args.update:
+                lines[lineIndex] = lines[lineIndex].replace(" %s" % expected, " %s" % actual, 1)
+            elif expected == "-":
+                unrecorded += 1
+            elif actual != expected:
+                print("Sequence %s: rendered %s, expected %s" % (seqId, actual, expected), file=sys.stderr)
+                failed += 1
+
+    if args.update:
+        with open(args.hashes, "w") as f:
+            f.write("\n".join(lines) + "\n")
+        print("Recorded the hashes of %d renders in %s" % (len(entries), args.hashes))
+        return
+
+    if unrecorded != 0:
+        print("%d renders have no recorded hash yet, run make audio-render-hashes to record them" % unrecorded)
+    if failed != 0:
+        sys.exit("error: %d of %d renders changed" % (failed, len(entries)))
+    if unrecorded != len(entries):
+        print("All %d recorded renders match" % (len(entries) - unrecorded))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,245 @@
+/**
+ * rsp_audio_test: checks rsp_audio.c against hand-built audio command lists, without a ROM.
+ *
+ * Each command list runs one part of the ABI on fixed input: ADPCM decoding (including continuing
+ * from the saved state), resampling, the envelope mixer, mixing, interleaving and DMEM moves.
+ * The output is compared against the expected buffers below. The ADPCM buffers follow the decoder in
+ * tools/aifc_decode.c, and the rest follow the fixed point arithmetic of the rsp/audio.s commands.
+ *
+ * Built and run by `make audio-render-test`. Exits with 1 if any output differs.
+ */
+
+#include <ultra64.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "macros.h"
+#include "rsp_audio.h"
+
+#define DMEM_ADPCM_IN       0x000
+#define DMEM_ADPCM_OUT      0x100
+#define DMEM_RESAMPLE_IN    0x400
+#define DMEM_RESAMPLE_OUT   0x500
+#define DMEM_ENV_IN         0x600
+#define DMEM_ENV_DRY_LEFT   0x700
+#define DMEM_ENV_DRY_RIGHT  0x720
+#define DMEM_ENV_WET_LEFT   0x740
+#define DMEM_ENV_WET_RIGHT  0x760
+#define DMEM_MIX_IN         0x800
+#define DMEM_MIX_HALF       0x840
+#define DMEM_MIX_SUBTRACT   0x860
+#define DMEM_INTERLEAVED    0x900
+#define DMEM_MOVED          0x980
+
+// Three ADPCM frames: a header with the shift and predictor, then 16 nibbles.
+static ALIGNED16 u8 sAdpcmFrames[32] = {
+    0x20, 0x12, 0x34, 0x56, 0x70, 0x9A, 0xBC, 0xDE, 0xF1,
+    0x30, 0x7F, 0x80, 0x17, 0x71, 0xE2, 0x2E, 0x05, 0x50,
+    0x10, 0x00, 0x11, 0x22, 0x33, 0xFF, 0xEE, 0xDD, 0xCC,
+};
+
+// An order 2 codebook with a single predictor.
+static ALIGNED16 s16 sAdpcmBook[2][8] = {
+    { -1200, -900, -600, -300, 0, 300, 600, 900 },
+    { 2600, 2200, 1800, 1400, 1000, 600, 200, -200 },
+};
+
+static ALIGNED16 s16 sResampleIn[24];
+static ALIGNED16 s16 sEnvIn[16];
+static ALIGNED16 s16 sMixIn[16];
+static ALIGNED16 s16 sMixOut[16];
+
+static ALIGNED16 s16 sAdpcmState[16];
+static ALIGNED16 s16 sResampleState[2][16];
+static ALIGNED16 s16 sEnvState[40];
+
+static ALIGNED16 s16 sAdpcmOut[48];
+static ALIGNED16 s16 sResampleOut[2][16];
+static ALIGNED16 s16 sEnvOut[4][16];
+static ALIGNED16 s16 sMixResult[2][16];
+static ALIGNED16 s16 sInterleavedOut[32];
+static ALIGNED16 s16 sMovedOut[16];
+
+static Acmd sCmds[64];
+
+static const s16 sExpectedAdpcm[48] = {
+    4, 13, 26, 43, 62, 84, 107, 98,
+    33, -2, -26, -41, -47, -44, -34, -14,
+    58, 62, -17, -46, -37, 22, 93, 104,
+    61, 66, 83, 64, 50, 84, 128, 124,
+    82, 76, 73, 70, 69, 68, 68, 67,
+    43, 37, 30, 22, 14, 5, -4, -13,
+};
+
+static const s16 sExpectedResampleUnity[16] = {
+    0, 9, -925, -7991, -7492, -5993, -4492, -2992,
+    -1491, 10, 1509, 3010, 4510, 6012, 7511, 9012,
+};
+
+static const s16 sExpectedResampleSlow[16] = {
+    0, 0, 58, -433, -4585, -8348, -7926, -6926,
+    -5993, -5052, -4111, -3176, -2240, -1300, -365, 575,
+};
+
+static const s16 sExpectedEnvDryLeft[16] = {
+    -3984, -3656, -3266, -2812, -2297, -1719, -1078, -375,
+    398, 1266, 2227, 3281, 4430, 5672, 7007, 8437,
+};
+
+static const s16 sExpectedEnvDryRight[16] = {
+    -5625, -4875, -4125, -3375, -2625, -1875, -1125, -375,
+    375, 1125, 1875, 2625, 3375, 4125, 4875, 5625,
+};
+
+static const s16 sExpectedEnvWetLeft[16] = {
+    -996, -914, -816, -703, -574, -430, -270, -94,
+    100, 316, 557, 820, 1107, 1418, 1752, 2109,
+};
+
+static const s16 sExpectedEnvWetRight[16] = {
+    -1406, -1219, -1031, -844, -656, -469, -281, -94,
+    94, 281, 469, 656, 844, 1031, 1219, 1406,
+};
+
+static const s16 sExpectedMixHalf[16] = {
+    2000, 1800, 1600, 1400, 1200, 1000, 800, 600,
+    400, 200, 0, -200, -400, -600, -800, -1000,
+};
+
+static const s16 sExpectedMixSubtract[16] = {
+    32000, 27300, 22600, 17900, 13200, 8500, 3800, -900,
+    -5600, -10300, -15000, -19700, -24400, -29100, -32768, -32768,
+};
+
+static s32 sNumChecks = 0;
+static s32 sNumFailed = 0;
+
+static void check_buffer(const char *name, const s16 *actual, const s16 *expected, s32 count) {
+    s32 i;
+
+    sNumChecks++;
+    for (i = 0; i < count; i++) {
+        if (actual[i] != expected[i]) {
+            fprintf(stderr, "%s: sample %d is %d, expected %d\n", name, i, actual[i], expected[i]);
+            sNumFailed++;
+            return;
+        }
+    }
+}
+
+static void init_inputs(void) {
+    s32 i;
+
+    for (i = 0; i < 24; i++) {
+        sResampleIn[i] = (i * 1500 - 9000);
+    }
+    for (i = 0; i < 16; i++) {
+        sEnvIn[i] = (i * 2000 - 15000);
+        sMixIn[i] = (i * 3000 - 20000);
+        sMixOut[i] = (12000 - i * 1700);
+    }
+}
+
+static s32 build_commands(Acmd *cmd) {
+    Acmd *start = cmd;
+
+    // ADPCM: decode two frames from the start, then the third one continuing from the saved state.
+    aLoadADPCM(cmd++, sizeof(sAdpcmBook), sAdpcmBook);
+    aSetBuffer(cmd++, 0, DMEM_ADPCM_IN, 0, sizeof(sAdpcmFrames));
+    aLoadBuffer(cmd++, sAdpcmFrames);
+    aSetBuffer(cmd++, 0, DMEM_ADPCM_IN, DMEM_ADPCM_OUT, 32 * sizeof(s16));
+    aADPCMdec(cmd++, A_INIT, sAdpcmState);
+    aSetBuffer(cmd++, 0, 0, DMEM_ADPCM_OUT + 16 * sizeof(s16), 32 * sizeof(s16));
+    aSaveBuffer(cmd++, sAdpcmOut);
+    aSetBuffer(cmd++, 0, DMEM_ADPCM_IN + 18, DMEM_ADPCM_OUT, 16 * sizeof(s16));
+    aADPCMdec(cmd++, A_CONTINUE, sAdpcmState);
+    aSetBuffer(cmd++, 0, 0, DMEM_ADPCM_OUT + 16 * sizeof(s16), 16 * sizeof(s16));
+    aSaveBuffer(cmd++, sAdpcmOut + 32);
+
+    // Resample at the same rate, then at 5/8 of it.
+    aSetBuffer(cmd++, 0, DMEM_RESAMPLE_IN, 0, sizeof(sResampleIn));
+    aLoadBuffer(cmd++, sResampleIn);
+    aSetBuffer(cmd++, 0, DMEM_RESAMPLE_IN, DMEM_RESAMPLE_OUT, 16 * sizeof(s16));
+    aResample(cmd++, A_INIT, 0x8000, sResampleState[0]);
+    aSaveBuffer(cmd++, sResampleOut[0]);
+    aResample(cmd++, A_INIT, 0x5000, sResampleState[1]);
+    aSaveBuffer(cmd++, sResampleOut[1]);
+
+    // Envelope mixer: the left channel ramps up to its target, the right one stays, with a wet send on both.
+    aSetBuffer(cmd++, 0, DMEM_ENV_IN, 0, sizeof(sEnvIn));
+    aLoadBuffer(cmd++, sEnvIn);
+    aClearBuffer(cmd++, DMEM_ENV_DRY_LEFT, 4 * 16 * sizeof(s16));
+    aSetVolume(cmd++, A_VOL | A_LEFT, 0x2000, 0, 0);
+    aSetVolume(cmd++, A_VOL | A_RIGHT, 0x3000, 0, 0);
+    aSetVolume32(cmd++, A_RATE | A_LEFT, 0x5000, 0x18000);
+    aSetVolume32(cmd++, A_RATE | A_RIGHT, 0x3000, 0x10000);
+    aSetVolume(cmd++, A_AUX, 0x7FFF, 0, 0x2000);
+    aSetBuffer(cmd++, A_AUX, DMEM_ENV_DRY_RIGHT, DMEM_ENV_WET_LEFT, DMEM_ENV_WET_RIGHT);
+    aSetBuffer(cmd++, 0, DMEM_ENV_IN, DMEM_ENV_DRY_LEFT, sizeof(sEnvIn));
+    aEnvMixer(cmd++, A_INIT | A_AUX, sEnvState);
+    aSetBuffer(cmd++, 0, 0, DMEM_ENV_DRY_LEFT, 4 * 16 * sizeof(s16));
+    aSaveBuffer(cmd++, sEnvOut);
+
+    // Mix at half gain, and at -100% gain, which subtracts.
+    aSetBuffer(cmd++, 0, DMEM_MIX_IN, 0, sizeof(sMixIn));
+    aLoadBuffer(cmd++, sMixIn);
+    aSetBuffer(cmd++, 0, DMEM_MIX_HALF, 0, sizeof(sMixOut));
+    aLoadBuffer(cmd++, sMixOut);
+    aSetBuffer(cmd++, 0, DMEM_MIX_SUBTRACT, 0, sizeof(sMixOut));
+    aLoadBuffer(cmd++, sMixOut);
+    aSetBuffer(cmd++, 0, 0, 0, 16 * sizeof(s16));
+    aMix(cmd++, 0, 0x4000, DMEM_MIX_IN, DMEM_MIX_HALF);
+    aMix(cmd++, 0, 0x8000, DMEM_MIX_IN, DMEM_MIX_SUBTRACT);
+    aSetBuffer(cmd++, 0, 0, DMEM_MIX_HALF, 2 * 16 * sizeof(s16));
+    aSaveBuffer(cmd++, sMixResult);
+
+    // Interleave the envelope mixer's dry channels, and move the mix input.
+    aSetBuffer(cmd++, 0, 0, DMEM_INTERLEAVED, 16 * sizeof(s16));
+    aInterleave(cmd++, DMEM_ENV_DRY_LEFT, DMEM_ENV_DRY_RIGHT);
+    aSetBuffer(cmd++, 0, 0, DMEM_INTERLEAVED, 32 * sizeof(s16));
+    aSaveBuffer(cmd++, sInterleavedOut);
+    aDMEMMove(cmd++, DMEM_MIX_IN, DMEM_MOVED, sizeof(sMixIn));
+    aSetBuffer(cmd++, 0, 0, DMEM_MOVED, sizeof(sMixIn));
+    aSaveBuffer(cmd++, sMovedOut);
+
+    return (cmd - start);
+}
+
+int main(void) {
+    s16 expectedInterleaved[32];
+    s32 numCmds;
+    s32 i;
+
+    init_inputs();
+    numCmds = build_commands(sCmds);
+
+    if (rsp_audio_run(sCmds, numCmds) != numCmds) {
+        fprintf(stderr, "rsp_audio_test: the command list didn't run to the end\n");
+        return 1;
+    }
+
+    for (i = 0; i < 16; i++) {
+        expectedInterleaved[i * 2 + 0] = sExpectedEnvDryLeft[i];
+        expectedInterleaved[i * 2 + 1] = sExpectedEnvDryRight[i];
+    }
+
+    check_buffer("ADPCM decode", sAdpcmOut, sExpectedAdpcm, ARRAY_COUNT(sExpectedAdpcm));
+    check_buffer("Resample at 1x", sResampleOut[0], sExpectedResampleUnity, ARRAY_COUNT(sExpectedResampleUnity));
+    check_buffer("Resample at 5/8x", sResampleOut[1], sExpectedResampleSlow, ARRAY_COUNT(sExpectedResampleSlow));
+    check_buffer("Envelope mixer dry left", sEnvOut[0], sExpectedEnvDryLeft, ARRAY_COUNT(sExpectedEnvDryLeft));
+    check_buffer("Envelope mixer dry right", sEnvOut[1], sExpectedEnvDryRight, ARRAY_COUNT(sExpectedEnvDryRight));
+    check_buffer("Envelope mixer wet left", sEnvOut[2], sExpectedEnvWetLeft, ARRAY_COUNT(sExpectedEnvWetLeft));
+    check_buffer("Envelope mixer wet right", sEnvOut[3], sExpectedEnvWetRight, ARRAY_COUNT(sExpectedEnvWetRight));
+    check_buffer("Mix at half gain", sMixResult[0], sExpectedMixHalf, ARRAY_COUNT(sExpectedMixHalf));
+    check_buffer("Mix at -100% gain", sMixResult[1], sExpectedMixSubtract, ARRAY_COUNT(sExpectedMixSubtract));
+    check_buffer("Interleave", sInterleavedOut, expectedInterleaved, ARRAY_COUNT(expectedInterleaved));
+    check_buffer("DMEM move", sMovedOut, sMixIn, ARRAY_COUNT(sMovedOut));
+
+    if (sNumFailed != 0) {
+        fprintf(stderr, "rsp_audio_test: %d of %d checks failed\n", sNumFailed, sNumChecks);
+        return 1;
+    }
+
+    printf("rsp_audio_test: all %d checks passed\n", sNumChecks);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Computes the potentially visible rooms of each room of an area from its collision and room data,
+for use with ROOM_VISIBILITY_CULLING.
+
+Two rooms are connected when a triangle of one shares a vertex position with a triangle of the other,
+which is how doorways and openings between rooms look in collision. By default a room can see every
+room it is connected to through any number of openings, and itself. Areas whose rooms are closed off
+by doors can pass --depth to only see rooms within that many connections (1 sees the rooms next to it).
+Room 0 is the global room, which is always visible, so it doesn't connect other rooms together.
+Rooms that should see further, such as across a courtyard, can be joined by hand with --link.
+
+Usage: room_pvs.py <collision.inc.c> <room.inc.c> <symbol> [--depth N] [--link A:B ...] > <room_pvs.inc.c>
+
+Then add ROOM_VISIBILITY(<number of rooms>, <symbol>) to the area's level script, after ROOMS.
+"""
+import sys
+import re
+import argparse
+from collections import deque
+
+ROOM_VISIBILITY_WORDS = 4
+MAX_ROOMS = ROOM_VISIBILITY_WORDS * 32
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+def read_collision(path):
+    text = strip_comments(open(path).read())
+    vertices = [tuple(int(v, 0) for v in m) for m in re.findall(r"COL_VERTEX\(\s*(-?\w+)\s*,\s*(-?\w+)\s*,\s*(-?\w+)\s*\)", text)]
+    # Rooms are given per triangle, in the order the triangles are loaded in.
+    triangles = [tuple(int(v, 0) for v in m) for m in re.findall(r"COL_TRI(?:_SPECIAL)?\(\s*(\w+)\s*,\s*(\w+)\s*,\s*(\w+)\s*[,)]", text)]
+    return vertices, triangles
+
+def read_rooms(path):
+    text = strip_comments(open(path).read())
+    body = text[text.index("{") + 1:text.rindex("}")]
+    return [int(v, 0) for v in re.findall(r"-?\w+", body)]
+
+def main():
+    parser = argparse.ArgumentParser(description="Compute potentially visible room sets from collision room data.")
+    parser.add_argument("collision")
+    parser.add_argument("rooms")
+    parser.add_argument("symbol")
+    parser.add_argument("--depth", type=int, default=None, help="how many room connections a room can see through (unlimited by default)")
+    parser.add_argument("--link", action="append", default=[], metavar="A:B", help="make rooms A and B connected")
+    args = parser.parse_args()
+
+    vertices, triangles = read_collision(args.collision)
+    rooms = read_rooms(args.rooms)
+
+    if len(rooms) < len(triangles):
+        print("warning: %d triangles but only %d rooms, the rest are treated as room 0" % (len(triangles), len(rooms)), file=sys.stderr)
+
+    numRooms = max(rooms, default=0) + 1
+    if numRooms > MAX_ROOMS:
+        sys.exit("error: room %d is over the limit of %d rooms" % (numRooms - 1, MAX_ROOMS - 1))
+
+    # Find the rooms touching each vertex position.
+    roomsAtVertex = {}
+    for i, tri in enumerate(triangles):
+        room = rooms[i] if i < len(rooms) else 0
+        if room <= 0:
+            continue
+        for v in tri:
+            roomsAtVertex.setdefault(vertices[v], set()).add(room)
+
+    connections = [set() for _ in range(numRooms)]
+    for touching in roomsAtVertex.values():
+        for a in touching:
+            connections[a] |= touching
+    for link in args.link:
+        try:
+            a, b = (int(r, 0) for r in link.split(":"))
+        except ValueError:
+            sys.exit("error: --link %s should be two room numbers, as A:B" % link)
+        for r in (a, b):
+            if not 0 < r < numRooms:
+                sys.exit("error: --link %s: room %d can't be linked, the area's rooms are 1 to %d" % (link, r, numRooms - 1))
+        connections[a].add(b)
+        connections[b].add(a)
+
+    depthText = "unlimited depth" if args.depth is None else "a depth of %d" % args.depth
+    print("// Generated by tools/room_pvs.py from %s and %s with %s." % (args.collision, args.rooms, depthText))
+    print("const RoomVisibility %s[] = {" % args.symbol)
+    for room in range(numRooms):
+        visible = {room}
+        queue = deque([(room, 0)])
+        while queue:
+            current, depth = queue.popleft()
+            if depth == args.depth:
+                continue
+            for other in connections[current]:
+                if other not in visible:
+                    visible.add(other)
+                    queue.append((other, depth + 1))
+
+        words = [0] * ROOM_VISIBILITY_WORDS
+        for r in visible:
+            words[r // 32] |= 1 << (r % 32)
+        print("    { %s }, // Room %d" % (", ".join("0x%08X" % w for w in words), room))
+    print("};")
+
+if __name__ == "__main__":
+    main()